@@ -0,0 +1,166 @@
+/**
+\file   cmd_pos_publisher.cpp
+\brief  publishes the waypoints of the test trajectory, see cmd_pos_publisher.h
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#include "cmd_pos_publisher.h"
+#include <algorithm>
+#include "ros/package.h"
+#include "std_msgs/Float64MultiArray.h"
+#include "trajectory_msgs/JointTrajectory.h"
+#include "trajectory_file.h"
+
+
+CmdPosPublisher::CmdPosPublisher(const ros::NodeHandle &nh, const ros::NodeHandle &pnh): nh_(nh), running_(true){
+    pnh.param<std::string>("trajectory", trajectory_path_,
+                           ros::package::getPath("trajectory_controller") + "/trajectories/test_trajectory_1.traj");
+    pnh.param("chunk_size", chunk_size_, 0);
+    cmd_pos_pub_ = nh_.advertise<std_msgs::Float64MultiArray>("cmd_pos", 1000);
+    if (chunk_size_ > 0) {
+        cmd_traj_pub_ = nh_.advertise<trajectory_msgs::JointTrajectory>("cmd_traj", 10);
+        ros::NodeHandle ack_nh(nh_);
+        ack_nh.setCallbackQueue(&ack_queue_);
+        sub_ack_ = ack_nh.subscribe("cmd_traj_ack", 10, &CmdPosPublisher::ack_call_back, this);
+    }
+}
+
+
+CmdPosPublisher::~CmdPosPublisher(){
+    stop();
+}
+
+
+bool CmdPosPublisher::start(){
+    running_ = true;
+    thread_ = std::thread(&CmdPosPublisher::run, this);
+    return true;
+}
+
+
+void CmdPosPublisher::stop(){
+    running_ = false;
+    if (thread_.joinable())
+        thread_.join();
+}
+
+
+bool CmdPosPublisher::sleep_for(double t){
+    const ros::Time end = ros::Time::now() + ros::Duration(t);
+    while (running_ && ros::ok()) {
+        const double left = (end - ros::Time::now()).toSec();
+        if (left <= 0)
+            return true;
+        ros::Duration(left < 0.1 ? left : 0.1).sleep();
+    }
+    return false;
+}
+
+
+void CmdPosPublisher::run(){
+    //============ read trajectory ==========
+    TrajectoryFile traj;
+    if (!traj.open(trajectory_path_) || !traj.verify()) {
+        ROS_ERROR_STREAM("trajectory: " << traj.error());
+        return;
+    }
+    const int n_jts = traj.n_joints();
+    const int n_pts = traj.n_points();
+    ROS_INFO_STREAM( trajectory_path_ << ": number of joints, and points: "<< n_jts << ", "<<n_pts );
+    if (!sleep_for(1))
+        return;
+
+    if (chunk_size_ > 0) {
+        send_chunks(traj);
+        return;
+    }
+
+    //send waypoints of the trajectory, one by one according to time, a new message for each one
+    const double *T_wpt = traj.time();
+    for (int pt=0; pt<n_pts; pt++)
+    {
+        std_msgs::Float64MultiArrayPtr msg(new std_msgs::Float64MultiArray);
+        msg->data.resize(n_jts);
+        for (int jt=0; jt<n_jts; jt++)
+            msg->data[jt] = traj.pos(jt)[pt];
+        cmd_pos_pub_.publish(msg);
+        ROS_INFO_STREAM( "pt: "<< pt << ", T: " << T_wpt[pt] << ",  value: "<< traj.pos(0)[pt] );
+        if (!sleep_for(T_wpt[pt]))
+            return;
+    }
+
+    //send one way point, not full trajectory
+    std_msgs::Float64MultiArrayPtr msg(new std_msgs::Float64MultiArray);
+    for (int jt=0; jt<n_jts; jt++)
+        msg->data.push_back(.1*jt + .4);
+    cmd_pos_pub_.publish(msg);
+}
+
+
+void CmdPosPublisher::ack_call_back(const custom_msgs::traj_ack_msg::ConstPtr &msg){
+    last_ack_ = msg;
+}
+
+
+bool CmdPosPublisher::wait_ack(const ros::Time &stamp, double timeout){
+    const ros::WallTime end = ros::WallTime::now() + ros::WallDuration(timeout);
+    while (running_ && ros::ok() && ros::WallTime::now() < end) {
+        ack_queue_.callAvailable(ros::WallDuration(0.01));
+        if (last_ack_ && last_ack_->header.stamp == stamp)
+            return true;
+    }
+    return false;
+}
+
+
+bool CmdPosPublisher::send_chunks(const TrajectoryFile &traj){
+    const int n_jts = traj.n_joints();
+    const size_t n_pts = traj.n_points();
+    std::vector<std::string> joint_names(n_jts);
+    for (int jt=0; jt<n_jts; jt++)
+        joint_names[jt] = traj.joint_name(jt);
+
+    // a chunk published before the controller is connected would be lost
+    while (cmd_traj_pub_.getNumSubscribers() == 0 || sub_ack_.getNumPublishers() == 0)
+        if (!sleep_for(0.1))
+            return false;
+
+    for (size_t first=0; first<n_pts; ) {
+        const size_t n = std::min((size_t)chunk_size_, n_pts - first);
+        trajectory_msgs::JointTrajectoryPtr msg(new trajectory_msgs::JointTrajectory);
+        msg->header.stamp = ros::Time::now();
+        msg->joint_names = joint_names;
+        msg->points.resize(n);
+        for (size_t pt=0; pt<n; pt++) {
+            trajectory_msgs::JointTrajectoryPoint &point = msg->points[pt];
+            point.positions.resize(n_jts);
+            for (int jt=0; jt<n_jts; jt++)
+                point.positions[jt] = traj.pos(jt)[first + pt];
+            point.time_from_start = ros::Duration(traj.time()[first + pt]);
+        }
+        cmd_traj_pub_.publish(msg);
+
+        if (!wait_ack(msg->header.stamp, 5.0)) {
+            if (running_ && ros::ok())
+                ROS_ERROR_STREAM("cmd_traj: no ack of the chunk of points " << first << ".." << first + n - 1);
+            return false;
+        }
+        if (last_ack_->accepted) {
+            ROS_INFO_STREAM("cmd_traj: points " << first << ".." << first + n - 1 << " of " << n_pts << " queued, "
+                            << last_ack_->n_pending << " pending");
+            first += n;
+            continue;
+        }
+        // the queue is full: sent again when the controller has taken more waypoints
+        if (n <= last_ack_->capacity && n > last_ack_->capacity - last_ack_->n_pending) {
+            if (!sleep_for(0.1))
+                return false;
+            continue;
+        }
+        ROS_ERROR_STREAM("cmd_traj: chunk of points " << first << ".." << first + n - 1 << " rejected: "
+                         << last_ack_->error);
+        return false;
+    }
+    return true;
+}
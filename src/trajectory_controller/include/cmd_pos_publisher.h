@@ -0,0 +1,71 @@
+/**
+\file   cmd_pos_publisher.h
+\brief  publishes the waypoints of the test trajectory on "cmd_pos", used by cmd_pos_publisher and its nodelet.
+ *
+ *  the waypoints of the trajectory file ~trajectory (trajectory_file.h, default
+ *  trajectories/test_trajectory_1.traj of the package) are sent one by one, waiting the time_from_start of
+ *  each waypoint after it, then one more waypoint (0.1*jt + 0.4). a trajectory file is made from a toppra
+ *  yaml or a bag by scripts/trajectory_converter.py, no rebuild.
+ *  every waypoint is a new message published as a pointer, so the controllers loaded in the same nodelet
+ *  manager get it without serialization.
+ *  with ~chunk_size > 0 the trajectory is sent in bulk instead: JointTrajectory chunks of chunk_size points
+ *  on "cmd_traj" (trajectory_chunk.h), each one after the ack of the previous one on "cmd_traj_ack", a chunk
+ *  rejected because the queue of the controller is full is sent again 0.1 s later. no timing between the
+ *  waypoints and no extra waypoint then, the controller approaches them in order.
+ *
+ *  usage:
+ *      executable:  CmdPosPublisher pub(nh, pnh);  pub.run();
+ *      nodelet:     pub.start();  ...  pub.stop();
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef CMD_POS_PUBLISHER_H
+#define CMD_POS_PUBLISHER_H
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include "ros/ros.h"
+#include "ros/callback_queue.h"
+#include "custom_msgs/traj_ack_msg.h"
+
+class TrajectoryFile;
+
+
+class CmdPosPublisher
+{
+public:
+    CmdPosPublisher(const ros::NodeHandle &nh, const ros::NodeHandle &pnh);
+    ~CmdPosPublisher();
+
+    // sends the trajectory, returns after the last waypoint or after stop()
+    void run();
+    // run() in its own thread
+    bool start();
+    // ends run() at the next waypoint and waits for the thread
+    void stop();
+
+private:
+    // sleeps t seconds, false if stopped meanwhile
+    bool sleep_for(double t);
+    // the trajectory in chunks on cmd_traj, false if one was not acked or rejected
+    bool send_chunks(const TrajectoryFile &traj);
+    // waits for the ack of the chunk sent at stamp, false after timeout [s] or if stopped
+    bool wait_ack(const ros::Time &stamp, double timeout);
+    void ack_call_back(const custom_msgs::traj_ack_msg::ConstPtr &msg);
+
+    ros::NodeHandle nh_;
+    ros::Publisher cmd_pos_pub_;
+    ros::Publisher cmd_traj_pub_;
+    // acks served by run() only, on their own queue
+    ros::CallbackQueue ack_queue_;
+    ros::Subscriber sub_ack_;
+    custom_msgs::traj_ack_msg::ConstPtr last_ack_;
+    std::string trajectory_path_;
+    int chunk_size_;
+    std::atomic<bool> running_;
+    std::thread thread_;
+};
+
+#endif // CMD_POS_PUBLISHER_H
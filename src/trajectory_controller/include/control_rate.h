@@ -0,0 +1,78 @@
+/**
+\file   control_rate.h
+\brief  control rate of the controller nodes, read from the private parameters ~rate and ~substeps.
+ *
+ *  the node loop runs at ~rate [Hz] (ros::Rate), every loop the controller takes ~substeps steps of
+ *  1/(rate*substeps) s, so the integration step always follows the configured rate (the generated models
+ *  had 0.008 s fixed, which only matches 125 Hz).
+ *  e.g. rate=125, substeps=8: the node publishes at 125 Hz, the controller runs at 1 kHz and the 8 samples
+ *  of each loop are published together for a 1 kHz drive.
+ *  ~rt_thread (default false) runs the loop in a real-time thread (rt_loop.h) with ~rt_priority (SCHED_FIFO,
+ *  default 80) pinned to ~rt_cpu (default -1: not pinned), the callbacks are served by the main thread then.
+ *  in a nodelet the loop has always its own thread (thread()), real-time only with ~rt_thread.
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef CONTROL_RATE_H
+#define CONTROL_RATE_H
+
+#include "ros/ros.h"
+#include "rt_loop.h"
+
+
+struct control_rate {
+    double frq;     // loop rate of the node [Hz]
+    int substeps;   // controller steps per loop
+    bool rt_thread; // loop in a real-time thread instead of ros::Rate
+    int rt_priority;
+    int rt_cpu;
+
+    double step_size() const { return 1.0/(frq*substeps); }
+
+    rt_config rt() const {
+        rt_config c = rt_config::defaults(1.0/frq);
+        c.priority = rt_priority;
+        c.cpu = rt_cpu;
+        return c;
+    }
+
+    // loop thread of a nodelet: rt() with ~rt_thread, else the same deadlines with the normal scheduling
+    rt_config thread() const {
+        rt_config c = rt();
+        if (!rt_thread) {
+            c.priority = 0;
+            c.cpu = -1;
+            c.lock_memory = false;
+        }
+        return c;
+    }
+};
+
+
+// reads ~rate, ~substeps and the ~rt_ parameters, invalid values are replaced by the defaults
+inline control_rate read_control_rate(const ros::NodeHandle &pnh, double default_frq, int default_substeps = 1){
+    control_rate r;
+    pnh.param("rate", r.frq, default_frq);
+    pnh.param("substeps", r.substeps, default_substeps);
+    pnh.param("rt_thread", r.rt_thread, false);
+    pnh.param("rt_priority", r.rt_priority, 80);
+    pnh.param("rt_cpu", r.rt_cpu, -1);
+    if (!(r.frq > 0)) {
+        ROS_WARN_STREAM("~rate has to be positive, got " << r.frq << ", using " << default_frq);
+        r.frq = default_frq;
+    }
+    if (r.substeps < 1) {
+        ROS_WARN_STREAM("~substeps has to be at least 1, got " << r.substeps << ", using " << default_substeps);
+        r.substeps = default_substeps;
+    }
+    if (r.rt_priority < 0 || r.rt_priority > 99) {
+        ROS_WARN_STREAM("~rt_priority has to be in 0..99, got " << r.rt_priority << ", using 80");
+        r.rt_priority = 80;
+    }
+    ROS_INFO_STREAM("control rate: " << r.frq << " Hz, " << r.substeps << " substeps of " << r.step_size() << " s"
+                    << (r.rt_thread ? ", real-time thread" : ""));
+    return r;
+}
+
+#endif // CONTROL_RATE_H
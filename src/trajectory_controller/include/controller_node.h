@@ -0,0 +1,218 @@
+/**
+\file   controller_node.h
+\brief  common part of the controller nodes, runs as a standalone node or inside a nodelet manager.
+ *
+ *  holds the JerkLimitedController, the control rate (control_rate.h), the ~parameters updates
+ *  (parameter_updates.h), the state publishers with their message pools (message_pool.h) and the loop.
+ *  a node derives from it, subscribes to its command topic and implements cycle(): set the inputs of
+ *  the controller, then step_and_publish().
+ *  the node handles are given by the caller, so the same class is used by the executables (ros::NodeHandle
+ *  and ~) and by the nodelets (getNodeHandle and getPrivateNodeHandle, pipeline_nodelet.h): in a manager the
+ *  states are published as pointers to the other nodelets, without serialization.
+ *  published state: (pos, vel, acc, jrk) of each joint then the setpoint of each joint, N*5 values,
+ *  with substeps > 1 the states of all the substeps on "<state_topic>_substeps", N*4 values per substep.
+ *  the phases of the loop are timed and published on /diagnostics at 1 Hz (cycle_diagnostics.h).
+ *  the loop does not log: it records values in trace_ (trace_log.h), the drain thread logs every
+ *  ~trace_decimation-th record of each event with ROS_INFO (default: the control rate, one line per second
+ *  and event; 1: every cycle, 0: none) and writes all of them to the binary file ~trace_file (default "": none).
+ *
+ *  usage:
+ *      executable:  MyNode node(nh, pnh);  return node.spin();
+ *      nodelet:     node.start();  ...  node.stop();
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef CONTROLLER_NODE_H
+#define CONTROLLER_NODE_H
+
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <new>
+#include <stdlib.h>
+#include "ros/ros.h"
+#include "std_msgs/Float64MultiArray.h"
+#include "jerk_limited_controller.h"
+#include "control_rate.h"
+#include "parameter_updates.h"
+#include "message_pool.h"
+#include "rt_loop.h"
+#include "trace_log.h"
+#include "cycle_diagnostics.h"
+
+
+template <int N>
+class ControllerNode
+{
+public:
+    typedef JerkLimitedController<N> controller_type;
+    static const int n_joints = N;
+
+    // the derived class has to call stop() in its destructor, the loop calls its cycle()
+    virtual ~ControllerNode(){}
+
+    // nodes may hold cache line aligned members (spsc_ring.h) while new of c++11 aligns to 16 bytes only
+    static void* operator new(size_t size){
+        void *p = NULL;
+        if (posix_memalign(&p, 64, size) != 0)
+            throw std::bad_alloc();
+        return p;
+    }
+    static void operator delete(void *p){ free(p); }
+
+    // standalone node: runs the loop until ros shuts down, ros::Rate and spinOnce in this thread,
+    // or the ~rt_thread with the callbacks served here by ros::spin. returns the exit code of main
+    int spin(){
+        if (rate_.rt_thread) {
+            if (!start())
+                return 1;
+            ros::spin();
+            stop();
+        }
+        else {
+            start_trace();
+            ros::Rate loop_rate(rate_.frq);
+            // deadlines of ros::Rate: one period after the last one, or after the wake up when a period late
+            const int64_t period = diagnostics_.period_ns();
+            int64_t deadline = monotonic_ns();
+            while (ros::ok()) {
+                loop_rate.sleep();
+                const int64_t wakeup = monotonic_ns();
+                deadline += period;
+                if (wakeup - deadline > period)
+                    deadline = wakeup;
+                ros::spinOnce();
+                diagnostics_.record(PHASE_CALLBACKS, monotonic_ns() - wakeup);
+                run_cycle(wakeup, deadline);
+            }
+            stop_trace();
+        }
+        controller_.terminate();
+        return 0;
+    }
+
+    // nodelet: runs the loop in its own thread (real-time with ~rt_thread), the callbacks are served by
+    // the threads of the manager. false if the thread could not be created
+    bool start(){
+        start_trace();
+        if (!loop_.start(rate_.thread(), std::bind(&ControllerNode::thread_cycle, this))) {
+            ROS_ERROR_STREAM("control thread: " << loop_.setup_report());
+            stop_trace();
+            return false;
+        }
+        ROS_INFO_STREAM("control thread: " << loop_.setup_report());
+        return true;
+    }
+
+    void stop(){
+        if (!loop_.running())
+            return;
+        loop_.stop();
+        ROS_INFO_STREAM("control thread: " << loop_.summary());
+        stop_trace();
+    }
+
+protected:
+    // the controller is initialized (zero states and inputs) with the step size of the control rate,
+    // the derived class sets the limits and gains
+    ControllerNode(const ros::NodeHandle &nh, const ros::NodeHandle &pnh, const std::string &state_topic,
+                   double default_frq):
+        nh_(nh), pnh_(pnh),
+        rate_(read_control_rate(pnh, default_frq)),
+        parameter_updates_(pnh),
+        diagnostics_(nh, pnh.getNamespace(), 1.0/rate_.frq),
+        state_pool_(16, prototype(N*5)),
+        substep_pool_(rate_.substeps > 1 ? 16 : 0, prototype(rate_.substeps*N*4))
+    {
+        pnh_.param("trace_decimation", trace_decimation_, std::max(1, (int)(rate_.frq + 0.5)));
+        pnh_.param("trace_file", trace_file_, std::string());
+        controller_.initialize();
+        controller_.set_step_size(rate_.step_size());
+        pub_state_ = nh_.advertise<std_msgs::Float64MultiArray>(state_topic, 1000);
+        if (rate_.substeps > 1)
+            pub_substep_state_ = nh_.advertise<std_msgs::Float64MultiArray>(state_topic + "_substeps", 1000);
+    }
+
+    // one loop of the node, called after the parameter updates are applied
+    virtual void cycle() = 0;
+
+    // substeps of the controller with its current inputs, then publishes the state and setpoint (N values)
+    void step_and_publish(const double *setpoint){
+        const typename controller_type::outputs &y = controller_.output();
+        std_msgs::Float64MultiArrayPtr substep_msg;
+        if (rate_.substeps > 1)
+            substep_msg = substep_pool_.acquire();
+        const int64_t t_step = monotonic_ns();
+        controller_.step_n(rate_.substeps, rate_.substeps > 1 ? &substep_msg->data[0] : NULL);
+        const int64_t t_publish = monotonic_ns();
+        diagnostics_.record(PHASE_STEP, t_publish - t_step);
+
+        //send the state (pos, vel, acc, jrk) for all the joint: 1st_jt=0:3, 2nd_jt=4:7, 3rd_jt:8_11 ..... and so on
+        // then the setpoint for all the joint: data[24, 25 .... 29]
+        std_msgs::Float64MultiArrayPtr state_msg = state_pool_.acquire();
+        double *state = &state_msg->data[0];
+        for (int i=0; i<N; i++) {
+            state[4*i]     = y.POS[i];
+            state[4*i + 1] = y.VEL[i];
+            state[4*i + 2] = y.ACC[i];
+            state[4*i + 3] = y.JRK[i];
+            state[4*N + i] = setpoint[i];
+        }
+        pub_state_.publish(state_msg);
+        if (rate_.substeps > 1)
+            pub_substep_state_.publish(substep_msg);
+        diagnostics_.record(PHASE_PUBLISH, monotonic_ns() - t_publish);
+    }
+
+    ros::NodeHandle nh_;
+    ros::NodeHandle pnh_;
+    const control_rate rate_;
+    controller_type controller_;
+    // events are added by the constructor of the derived class, recorded only by cycle()
+    TraceLog trace_;
+
+private:
+    // cycle woken up at wakeup [ns] for its deadline [ns]
+    void run_cycle(int64_t wakeup, int64_t deadline){
+        parameter_updates_.apply(controller_);
+        cycle();
+        diagnostics_.end_cycle(wakeup - deadline, monotonic_ns() - wakeup);
+    }
+
+    // cycle of the loop thread
+    void thread_cycle(){
+        run_cycle(monotonic_ns(), loop_.deadline_ns());
+    }
+
+    void start_trace(){
+        if (!trace_.start(trace_decimation_, trace_file_, [](const std::string &line){ ROS_INFO_STREAM(line); }))
+            ROS_WARN_STREAM("~trace_file: could not open " << trace_file_ << ", no binary trace");
+    }
+
+    void stop_trace(){
+        trace_.stop();
+        if (trace_.n_dropped())
+            ROS_WARN_STREAM("trace: " << trace_.n_dropped() << " of " << trace_.n_recorded() + trace_.n_dropped()
+                            << " records dropped (ring full)");
+    }
+
+    static std_msgs::Float64MultiArray prototype(size_t n){
+        std_msgs::Float64MultiArray msg;
+        msg.data.resize(n);
+        return msg;
+    }
+
+    // limits and gains published on ~parameters, taken at the start of a loop
+    ParameterUpdates<controller_type> parameter_updates_;
+    CycleDiagnostics diagnostics_;
+    ros::Publisher pub_state_;
+    ros::Publisher pub_substep_state_;
+    MessagePool<std_msgs::Float64MultiArray> state_pool_;
+    MessagePool<std_msgs::Float64MultiArray> substep_pool_;
+    int trace_decimation_;
+    std::string trace_file_;
+    RtLoop loop_;
+};
+
+#endif // CONTROLLER_NODE_H
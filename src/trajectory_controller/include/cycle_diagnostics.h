@@ -0,0 +1,150 @@
+/**
+\file   cycle_diagnostics.h
+\brief  timing of the phases of the control loop, published on /diagnostics at 1 Hz.
+ *
+ *  the control loop measures its phases with the monotonic clock and records them in one LatencyHistogram
+ *  each (latency_histogram.h, lock-free, no allocation):
+ *      wakeup latency  time after the deadline when the loop wakes up
+ *      callbacks       ros::spinOnce (only when the callbacks run in the loop thread)
+ *      step            the substeps of the controller
+ *      publish         the state publishers
+ *      cycle           from the wake up to the end of the cycle
+ *  a cycle that ends after the next deadline is an overrun.
+ *  a timer of its own callback queue and spinner thread publishes a diagnostic_msgs/DiagnosticArray with
+ *  min, p50, p99, max [us] of every phase over the last second (within the 12.5 % of the histogram bins),
+ *  the cycles and the overruns; the level is WARN when there was an overrun in the last second, so it can
+ *  be alarmed on with the usual diagnostics tools (diagnostic_aggregator, rqt_robot_monitor).
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef CYCLE_DIAGNOSTICS_H
+#define CYCLE_DIAGNOSTICS_H
+
+#include <stdio.h>
+#include <string>
+#include <atomic>
+#include "ros/ros.h"
+#include "ros/callback_queue.h"
+#include "diagnostic_msgs/DiagnosticArray.h"
+#include "latency_histogram.h"
+
+
+enum cycle_phase {
+    PHASE_WAKEUP = 0,
+    PHASE_CALLBACKS,
+    PHASE_STEP,
+    PHASE_PUBLISH,
+    PHASE_CYCLE,
+    N_CYCLE_PHASES
+};
+
+
+class CycleDiagnostics
+{
+public:
+    // name of the status (e.g. the node name), period of the loop [s]; starts publishing
+    CycleDiagnostics(const ros::NodeHandle &nh, const std::string &name, double period):
+        nh_(nh), spinner_(1, &queue_), name_(name), period_ns_((int64_t)(period*1e9 + 0.5)), overruns_(0),
+        last_overruns_(0)
+    {
+        for (int p=0; p<N_CYCLE_PHASES; p++)
+            hist_[p].read(last_[p]);
+        nh_.setCallbackQueue(&queue_);
+        pub_ = nh_.advertise<diagnostic_msgs::DiagnosticArray>("/diagnostics", 10);
+        timer_ = nh_.createWallTimer(ros::WallDuration(1.0), &CycleDiagnostics::publish, this);
+        spinner_.start();
+    }
+
+    ~CycleDiagnostics(){ spinner_.stop(); }
+
+    // ---------- control loop ----------
+    void record(cycle_phase phase, int64_t ns){ hist_[phase].record(ns); }
+
+    // end of a cycle that woke up wakeup_ns after its deadline and took cycle_ns from the wake up
+    void end_cycle(int64_t wakeup_ns, int64_t cycle_ns){
+        hist_[PHASE_WAKEUP].record(wakeup_ns);
+        hist_[PHASE_CYCLE].record(cycle_ns);
+        if (wakeup_ns + cycle_ns > period_ns_)
+            overruns_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    int64_t period_ns() const { return period_ns_; }
+
+private:
+    void publish(const ros::WallTimerEvent&){
+        static const char *phase_names[N_CYCLE_PHASES] = {"wakeup latency", "callbacks", "step", "publish", "cycle"};
+
+        diagnostic_msgs::DiagnosticStatus status;
+        status.name = name_ + ": control loop";
+        const uint64_t overruns = overruns_.load(std::memory_order_relaxed);
+        const uint64_t new_overruns = overruns - last_overruns_;
+        last_overruns_ = overruns;
+
+        LatencyHistogram::snapshot now;
+        for (int p=0; p<N_CYCLE_PHASES; p++) {
+            hist_[p].read(now);
+            const latency_summary s = LatencyHistogram::summary(now, last_[p]);
+            last_[p] = now;
+            if (p == PHASE_CYCLE)
+                add(status, "cycles", s.count);
+            if (!now.count)   // never measured in this mode (e.g. callbacks in other threads)
+                continue;
+            const std::string phase = phase_names[p];
+            add(status, phase + " min [us]", 1e-3*s.min);
+            add(status, phase + " p50 [us]", 1e-3*s.p50);
+            add(status, phase + " p99 [us]", 1e-3*s.p99);
+            add(status, phase + " max [us]", 1e-3*s.max);
+        }
+        add(status, "overruns", new_overruns);
+        add(status, "overruns total", overruns);
+        add(status, "cycle max total [us]", 1e-3*hist_[PHASE_CYCLE].max());
+
+        if (new_overruns) {
+            status.level = diagnostic_msgs::DiagnosticStatus::WARN;
+            char msg[64];
+            snprintf(msg, sizeof(msg), "%llu overruns in the last second", (unsigned long long)new_overruns);
+            status.message = msg;
+        }
+        else {
+            status.level = diagnostic_msgs::DiagnosticStatus::OK;
+            status.message = "ok";
+        }
+
+        diagnostic_msgs::DiagnosticArray msg;
+        msg.header.stamp = ros::Time::now();
+        msg.status.push_back(status);
+        pub_.publish(msg);
+    }
+
+    static void add(diagnostic_msgs::DiagnosticStatus &status, const std::string &key, double value){
+        char str[32];
+        snprintf(str, sizeof(str), "%.1f", value);
+        diagnostic_msgs::KeyValue kv;
+        kv.key = key;
+        kv.value = str;
+        status.values.push_back(kv);
+    }
+
+    static void add(diagnostic_msgs::DiagnosticStatus &status, const std::string &key, uint64_t value){
+        diagnostic_msgs::KeyValue kv;
+        kv.key = key;
+        kv.value = std::to_string((unsigned long long)value);
+        status.values.push_back(kv);
+    }
+
+    ros::CallbackQueue queue_;
+    ros::NodeHandle nh_;
+    ros::AsyncSpinner spinner_;
+    ros::Publisher pub_;
+    ros::WallTimer timer_;
+    std::string name_;
+    int64_t period_ns_;
+    LatencyHistogram hist_[N_CYCLE_PHASES];
+    std::atomic<uint64_t> overruns_;
+    // publisher thread: state at the last publish
+    LatencyHistogram::snapshot last_[N_CYCLE_PHASES];
+    uint64_t last_overruns_;
+};
+
+#endif // CYCLE_DIAGNOSTICS_H
@@ -0,0 +1,98 @@
+/**
+\file   each_waypoint_controller.cpp
+\brief  controller approaching each waypoint, see each_waypoint_controller.h
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#include "each_waypoint_controller.h"
+
+static const double sm=180,  vm=130,  am=250, jm=985,  cnt= 1e-2, default_frq=125;
+static const size_t cmd_pos_capacity = 1024;
+
+
+EachWaypointController::EachWaypointController(const ros::NodeHandle &nh, const ros::NodeHandle &pnh):
+    ControllerNode<N_JOINTS>(nh, pnh, "/state_each_waypts", default_frq),
+    cmd_pos_(cnt, cmd_pos_capacity), cmd_pos_received_(false), cmd_traj_acks_(nh_)
+{
+    controller_.set_limits(sm, vm, am, jm);
+    controller_.set_gains(1200, 400, 20);
+    step_trace_ = trace_.add_event("STEP:", {"inpos=", "outpos=", "out_vel=", "out_acc="});
+    double blend_radius;
+    pnh_.param("blend_radius", blend_radius, 0.0);
+    cmd_pos_.set_blend_radius(blend_radius);
+    for (int jt=0; jt<n_joints; jt++) {
+        crnt_pos_[jt] = 0;
+        crnt_vel_[jt] = 0;
+    }
+    sub_cmd_pos_ = nh_.subscribe("/cmd_pos", 100, &EachWaypointController::cmd_call_back, this);
+    sub_cmd_traj_ = nh_.subscribe("/cmd_traj", 10, &EachWaypointController::cmd_traj_call_back, this);
+}
+
+
+EachWaypointController::~EachWaypointController(){
+    stop();
+}
+
+
+// command positions call_back
+void EachWaypointController::cmd_call_back(const std_msgs::Float64MultiArray::ConstPtr &msg){
+    if((int)msg->data.size() < n_joints){
+        ROS_WARN_STREAM("cmd_pos has " << msg->data.size() << " values, expected " << n_joints << " joints");
+        return;
+    }
+    std::lock_guard<std::mutex> lock(producer_mutex_);
+    if(!cmd_pos_.push(&msg->data[0])){  // backpressure: the loop has not taken the older waypoints yet
+        ROS_WARN_STREAM_THROTTLE(1, "cmd_pos queue full (" << cmd_pos_.capacity() << " waypoints), waypoint dropped, "
+                                 << cmd_pos_.n_dropped() << " dropped so far");
+        return;
+    }
+    cmd_pos_received_ = true;
+}
+
+
+// trajectory chunk call_back: checked once, all its points queued in one block, acked
+void EachWaypointController::cmd_traj_call_back(const trajectory_msgs::JointTrajectory::ConstPtr &msg){
+    const std::vector<trajectory_msgs::JointTrajectoryPoint> &points = msg->points;
+    std::string error;
+    bool accepted = check_chunk(*msg, n_joints, error);
+    std::lock_guard<std::mutex> lock(producer_mutex_);
+    if (accepted) {
+        accepted = cmd_pos_.push_n(points.size(), [&points](size_t i){ return &points[i].positions[0]; });
+        if (!accepted)  // backpressure: the sender resends it when the loop has taken more waypoints
+            error = std::to_string(points.size()) + " points, " + std::to_string(cmd_pos_.capacity()
+                    - cmd_pos_.n_pending()) + " free in the queue";
+    }
+    if (accepted)
+        cmd_pos_received_ = true;
+    else
+        ROS_WARN_STREAM_THROTTLE(1, "cmd_traj chunk rejected: " << error);
+    cmd_traj_acks_.publish(*msg, accepted, cmd_pos_.n_pending(), cmd_pos_.capacity(), error);
+}
+
+
+// one loop: next setpoint, substeps of the controller, publish
+void EachWaypointController::cycle(){
+    if(!cmd_pos_received_) // no waypoints have been recevied
+        return;
+
+    // next waypoint after reaching the current one (cnt, or blend_radius while moving towards it, for all
+    // the joints), else keep the same waypoint
+    controller_type::inputs &ctrl_U = controller_.input();
+    const double *wpt = cmd_pos_.update(crnt_pos_, crnt_vel_);
+    for (int jt=0; jt< n_joints; jt++)
+        ctrl_U.pos[jt] = wpt[jt];
+
+    // run the model STEP fumction, substeps times with the same waypoint
+    step_and_publish(ctrl_U.pos);
+
+    const controller_type::outputs &ctrl_Y = controller_.output();
+    for (int jt=0; jt< n_joints; jt++) {
+        crnt_pos_[jt] = ctrl_Y.POS[jt];
+        crnt_vel_[jt] = ctrl_Y.VEL[jt];
+    }
+
+    // logged by the trace thread
+    const double step_values[4] = {ctrl_U.pos[0], ctrl_Y.POS[0], ctrl_Y.VEL[0], ctrl_Y.ACC[0]};
+    trace_.record(step_trace_, step_values, 4);
+}
@@ -0,0 +1,57 @@
+/**
+\file   each_waypoint_controller.h
+\brief  controller approaching each waypoint, used by controller_approaching_each_waypoint and its nodelet.
+ *
+ *  subscribes to "/cmd_pos", the waypoints are approached one after the other (waypoint_sequencer.h), the
+ *  setpoint moves to the next one when all the joints are within cnt (0.01 rad) of the current one, or with
+ *  ~blend_radius > cnt (default 0: off) as soon as they are within blend_radius of it and not moving away:
+ *  the intermediate waypoints are passed at most about blend_radius away instead of slowing down to cnt at
+ *  each one (e.g. 0.05 saves about a third of the time of the test trajectories, batch_simulator).
+ *  whole trajectories come on "/cmd_traj" (trajectory_chunk.h): the positions of the points of each
+ *  JointTrajectory are queued as waypoints in one block, or none if the chunk is invalid or does not fit
+ *  in the free space of the queue, and the chunk is acked on "/cmd_traj_ack".
+ *  the state is published on "/state_each_waypts" (controller_node.h).
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef EACH_WAYPOINT_CONTROLLER_H
+#define EACH_WAYPOINT_CONTROLLER_H
+
+#include <atomic>
+#include <mutex>
+#include "controller_node.h"
+#include "waypoint_sequencer.h"
+#include "trajectory_chunk.h"
+
+#ifndef N_JOINTS
+#define N_JOINTS 6
+#endif
+
+
+class EachWaypointController: public ControllerNode<N_JOINTS>
+{
+public:
+    EachWaypointController(const ros::NodeHandle &nh, const ros::NodeHandle &pnh);
+    ~EachWaypointController();
+
+private:
+    void cmd_call_back(const std_msgs::Float64MultiArray::ConstPtr &msg);
+    void cmd_traj_call_back(const trajectory_msgs::JointTrajectory::ConstPtr &msg);
+    void cycle();
+
+    // waypoints received on cmd_pos and cmd_traj, pushed by the callbacks and taken by the control loop
+    // without locks. the two callbacks may run in different threads of a spinner: producer_mutex_ keeps
+    // them one producer, the loop never takes it
+    WaypointSequencer<N_JOINTS> cmd_pos_;
+    std::mutex producer_mutex_;
+    std::atomic<bool> cmd_pos_received_;
+    ros::Subscriber sub_cmd_pos_;
+    ros::Subscriber sub_cmd_traj_;
+    ChunkAcks cmd_traj_acks_;
+    double crnt_pos_[N_JOINTS];
+    double crnt_vel_[N_JOINTS];
+    int step_trace_;   // trace event of every loop: setpoint and state of joint 0
+};
+
+#endif // EACH_WAYPOINT_CONTROLLER_H
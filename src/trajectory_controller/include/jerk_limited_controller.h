@@ -0,0 +1,270 @@
+/**
+\file   jerk_limited_controller.h
+\brief  jerk limited trajectory controller for N joints, the number of joints is fixed at compile time.
+ *
+ *  this is a hand written version of the simulink models six_dof_pos_controller and six_dof_vel_controller,
+ *  each joint is a chain of three integrators (jrk -> acc -> vel -> pos), at every step the jerk is computed from
+ *  the error between the commanded setpoint (pos, vel, acc) and the output of the previous step:
+ *      jrk = kp*(pos_ref - POS) + kv*(vel_ref - VEL) + ka*(acc_ref - ACC),  limited by jm,
+ *  the outputs POS, VEL, ACC are the integrator states saturated by sm, vm, am.
+ *  setting kp=0 gives the velocity controller (six_dof_vel_controller), the pos input is ignored then.
+ *  the states are integrated with the fixed step ODE3 solver of the simulink models, so for N=6 the outputs
+ *  are the same as the generated code (except that the generated six_dof_pos_controller limits the velocity
+ *  of joint_0 with vm[1], here every joint uses its own vm).
+ *  set_solver(JLC_SOLVER_EXACT) propagates the constant jerk of the step in closed form instead, then the
+ *  outputs are the saturated states at the end of the step, more accurate than ODE3 but not cheaper.
+ *  the step size is 0.008 s by default, set_step_size() sets it from the rate of the node (control_rate.h).
+ *  all the data is stored in fixed size arrays inside the object (one array per quantity, structure-of-arrays),
+ *  no heap allocation and no globals, so many controllers (of different sizes) can run in the same process.
+ *  the whole state is one plain struct (snapshot), save()/restore() copy it with one memcpy, for previews
+ *  (steps_to_reach) or to roll back a speculative setpoint without initialize().
+ *  the step itself is done by jlc_step_ode3 (AVX-512/AVX2/scalar, selected at run time), link jlc_simd_kernel.
+ *
+ *  usage:
+ *      JerkLimitedController<6> ctrl;
+ *      ctrl.set_limits(sm, vm, am, jm);  ctrl.set_gains(kp, kv, ka);
+ *      ctrl.initialize();
+ *      loop: ctrl.input().pos[jt] = ...;  ctrl.step();  ctrl.output().POS[jt] ...
+ *      or:   ctrl.step_n(n_steps, buf);  // buf[k*4*N + 4*jt + 0..3]: POS, VEL, ACC, JRK after step k
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef JERK_LIMITED_CONTROLLER_H
+#define JERK_LIMITED_CONTROLLER_H
+
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <stdexcept>
+#include "jlc_simd_kernel.h"
+
+
+template <int N>
+class JerkLimitedController
+{
+public:
+    static const int n_joints = N;
+
+    // limits and gains for every joint
+    struct parameters {
+        double sm[N];  // pos limit
+        double vm[N];  // vel limit
+        double am[N];  // acc limit
+        double jm[N];  // jrk limit
+        double kp[N];  // gain of pos error
+        double kv[N];  // gain of vel error
+        double ka[N];  // gain of acc error
+    };
+
+    // commanded setpoint
+    struct inputs {
+        double pos[N];
+        double vel[N];
+        double acc[N];
+    };
+
+    // state of the joints after the step
+    struct outputs {
+        double POS[N];
+        double VEL[N];
+        double ACC[N];
+        double JRK[N];
+    };
+
+    // continuous states (the three integrators of each joint)
+    struct states {
+        double q[N];
+        double v[N];
+        double a[N];
+    };
+
+    // complete state of the controller, plain data: a copy of it restores the controller exactly
+    struct snapshot {
+        parameters prm;
+        inputs u;
+        outputs y;
+        states x;         // integrators
+        states dw;        // delays: outputs of the previous step
+        double step_size;
+        uint64_t ticks;
+        jlc_solver solver;
+    };
+
+    JerkLimitedController(): isa_(jlc_best_isa()){
+        memset(&s_, 0, sizeof(s_));
+        s_.step_size = 0.008;
+        s_.solver = JLC_SOLVER_ODE3;
+    }
+
+    // ---------- parameters ----------
+    // used from the next step on, the states are kept (limits and gains can change while running)
+    void set_parameters(const parameters &prm){ s_.prm = prm; }
+    const parameters& get_parameters() const { return s_.prm; }
+
+    // same limits for all the joints
+    void set_limits(double sm, double vm, double am, double jm){
+        for (int jt=0; jt<N; jt++) {
+            s_.prm.sm[jt] = sm;
+            s_.prm.vm[jt] = vm;
+            s_.prm.am[jt] = am;
+            s_.prm.jm[jt] = jm;
+        }
+    }
+
+    // same gains for all the joints, kp=0 for velocity control
+    void set_gains(double kp, double kv, double ka){
+        for (int jt=0; jt<N; jt++) {
+            s_.prm.kp[jt] = kp;
+            s_.prm.kv[jt] = kv;
+            s_.prm.ka[jt] = ka;
+        }
+    }
+
+    // parameters from an array (e.g. a parameter message): 7 values sm vm am jm kp kv ka for all the joints,
+    // or 7*N values sm[0..N-1], vm[0..N-1] .. ka[0..N-1]; false if the size is wrong, a limit is not positive
+    // or a gain is negative, prm is untouched then
+    static bool parameters_from_array(const double *d, size_t n, parameters &prm){
+        const int n_fields = sizeof(parameters) / sizeof(double) / N;
+        parameters p;
+        if (n == (size_t)n_fields) {
+            double *pd = reinterpret_cast<double*>(&p);
+            for (int f=0; f<n_fields; f++)
+                for (int jt=0; jt<N; jt++)
+                    pd[f*N + jt] = d[f];
+        }
+        else if (n == (size_t)n_fields*N)
+            memcpy(&p, d, sizeof(parameters));
+        else
+            return false;
+        for (int jt=0; jt<N; jt++)
+            if (!(p.sm[jt] > 0 && p.vm[jt] > 0 && p.am[jt] > 0 && p.jm[jt] > 0 &&
+                  p.kp[jt] >= 0 && p.kv[jt] >= 0 && p.ka[jt] >= 0))
+                return false;
+        prm = p;
+        return true;
+    }
+
+    // ---------- model ----------
+    // reset states, inputs and outputs to zero (like the generated initialize function)
+    void initialize(){
+        memset(&s_.u, 0, sizeof(s_.u));
+        memset(&s_.y, 0, sizeof(s_.y));
+        memset(&s_.x, 0, sizeof(s_.x));
+        memset(&s_.dw, 0, sizeof(s_.dw));
+        s_.ticks = 0;
+    }
+
+    // ---------- snapshot ----------
+    // save / restore everything that the next steps depend on (one memcpy each), e.g. to run a preview
+    // from the current state and go back:  snapshot s;  ctrl.save(s);  ... ctrl.step() ...;  ctrl.restore(s);
+    void save(snapshot &s) const { memcpy(&s, &s_, sizeof(snapshot)); }
+    void restore(const snapshot &s){ memcpy(&s_, &s, sizeof(snapshot)); }
+
+    // steps needed until every joint is within tol of target (pos inputs set to target), -1 if more than
+    // max_steps, the steps are a preview: the controller is restored afterwards
+    int steps_to_reach(const double *target, double tol, int max_steps){
+        snapshot s;
+        save(s);
+        for (int jt=0; jt<N; jt++)
+            s_.u.pos[jt] = target[jt];
+        int k = 0;
+        while (!within(target, tol)) {
+            if (k == max_steps) {
+                k = -1;
+                break;
+            }
+            step();
+            k++;
+        }
+        restore(s);
+        return k;
+    }
+
+    // integration step [s], 0.008 (125 Hz) by default like the simulink models, e.g. 1/(rate*substeps)
+    void set_step_size(double h){
+        if (!(h > 0))
+            throw(std::invalid_argument("JerkLimitedController: step size has to be positive"));
+        s_.step_size = h;
+    }
+
+    // integration mode: JLC_SOLVER_ODE3 (default, like the simulink models), EXACT, ODE1 or ODE4
+    void set_solver(jlc_solver solver){ s_.solver = solver; }
+    jlc_solver solver() const { return s_.solver; }
+    // instruction set of the kernel, the best one of the cpu by default
+    void set_isa(jlc_isa isa){ isa_ = isa; }
+    jlc_isa isa() const { return isa_; }
+
+    // one major step of step_size: update the outputs, compute the jerk and integrate the states,
+    // all the joints are stepped together by the vectorized kernel (jlc_simd_kernel.h)
+    void step(){
+        jlc_step(lanes(), s_.step_size, s_.solver, isa_);
+        s_.ticks++;
+    }
+
+    // n_steps steps with the inputs held (batch simulation), the outputs after step k are written to
+    // out[k*4*N ...] as POS, VEL, ACC, JRK of joint_0, then of joint_1 .. (the layout of the state messages),
+    // out has to hold n_steps*4*N values, or be NULL to only keep the last outputs
+    void step_n(int n_steps, double *out){
+        const jlc_lanes l = lanes();
+        for (int k=0; k<n_steps; k++) {
+            jlc_step(l, s_.step_size, s_.solver, isa_);
+            if (out) {
+                double *o = out + (size_t)k*4*N;
+                for (int jt=0; jt<N; jt++) {
+                    o[4*jt]     = s_.y.POS[jt];
+                    o[4*jt + 1] = s_.y.VEL[jt];
+                    o[4*jt + 2] = s_.y.ACC[jt];
+                    o[4*jt + 3] = s_.y.JRK[jt];
+                }
+            }
+        }
+        s_.ticks += n_steps;
+    }
+
+    // derivatives of the continuous states, evaluated with the saturated outputs
+    void derivatives(states &dx) const {
+        for (int jt=0; jt<N; jt++) {
+            dx.q[jt] = s_.y.VEL[jt];
+            dx.v[jt] = s_.y.ACC[jt];
+            dx.a[jt] = s_.y.JRK[jt];
+        }
+    }
+
+    void terminate(){}
+
+    // ---------- access ----------
+    inputs& input(){ return s_.u; }
+    const inputs& input() const { return s_.u; }
+    const outputs& output() const { return s_.y; }
+    const states& continuous_states() const { return s_.x; }
+    double step_size() const { return s_.step_size; }
+    // steps taken since initialize() times the step size (the step size is assumed constant meanwhile)
+    double time() const { return s_.ticks*s_.step_size; }
+
+private:
+    bool within(const double *target, double tol) const {
+        for (int jt=0; jt<N; jt++)
+            if (fabs(s_.y.POS[jt] - target[jt]) > tol)
+                return false;
+        return true;
+    }
+
+    // structure-of-arrays view of the joints for the kernel
+    jlc_lanes lanes(){
+        jlc_lanes l;
+        l.n = N;
+        l.sm = s_.prm.sm;  l.vm = s_.prm.vm;  l.am = s_.prm.am;  l.jm = s_.prm.jm;
+        l.kp = s_.prm.kp;  l.kv = s_.prm.kv;  l.ka = s_.prm.ka;
+        l.pos = s_.u.pos;  l.vel = s_.u.vel;  l.acc = s_.u.acc;
+        l.POS = s_.y.POS;  l.VEL = s_.y.VEL;  l.ACC = s_.y.ACC;  l.JRK = s_.y.JRK;
+        l.q = s_.x.q;  l.v = s_.x.v;  l.a = s_.x.a;
+        l.dq = s_.dw.q;  l.dv = s_.dw.v;  l.da = s_.dw.a;
+        return l;
+    }
+
+    snapshot s_;
+    jlc_isa isa_;
+};
+
+#endif // JERK_LIMITED_CONTROLLER_H
@@ -0,0 +1,118 @@
+/**
+\file   jlc_fleet.cpp
+\brief  batch of many jerk limited controllers stepped together, see jlc_fleet.h
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#include "jlc_fleet.h"
+#include <stdexcept>
+#include <algorithm>
+#include <thread>
+#include <stdint.h>
+
+
+JerkLimitedFleet::JerkLimitedFleet(int n_instances, int n_joints, double step_size):
+    n_inst_(n_instances), n_jts_(n_joints), n_lanes_(n_instances*n_joints), stride_((n_lanes_ + 7)/8*8),
+    step_size_(step_size), ticks_(0), solver_(JLC_SOLVER_ODE3), isa_(jlc_best_isa())
+{
+    if (n_instances <= 0 || n_joints <= 0)
+        throw(std::invalid_argument("JerkLimitedFleet: number of instances and joints has to be positive"));
+    if (step_size <= 0)
+        throw(std::invalid_argument("JerkLimitedFleet: step size has to be positive"));
+    buf_.assign((size_t)N_FIELDS*stride_ + 8, 0.0);
+    data_ = &buf_[0] + ((64 - (uintptr_t)&buf_[0] % 64) % 64)/sizeof(double);
+}
+
+
+void JerkLimitedFleet::set_limits(double sm, double vm, double am, double jm){
+    for (int inst=0; inst<n_inst_; inst++)
+        set_limits(inst, sm, vm, am, jm);
+}
+
+void JerkLimitedFleet::set_gains(double kp, double kv, double ka){
+    for (int inst=0; inst<n_inst_; inst++)
+        set_gains(inst, kp, kv, ka);
+}
+
+void JerkLimitedFleet::set_limits(int inst, double sm, double vm, double am, double jm){
+    for (int jt=0; jt<n_jts_; jt++) {
+        const int i = lane(inst, jt);
+        this->sm()[i] = sm;
+        this->vm()[i] = vm;
+        this->am()[i] = am;
+        this->jm()[i] = jm;
+    }
+}
+
+void JerkLimitedFleet::set_gains(int inst, double kp, double kv, double ka){
+    for (int jt=0; jt<n_jts_; jt++) {
+        const int i = lane(inst, jt);
+        this->kp()[i] = kp;
+        this->kv()[i] = kv;
+        this->ka()[i] = ka;
+    }
+}
+
+
+void JerkLimitedFleet::initialize(){
+    // keep the parameters, clear everything from the inputs on
+    std::fill(data_ + (size_t)U_POS*stride_, data_ + (size_t)N_FIELDS*stride_, 0.0);
+    ticks_ = 0;
+}
+
+
+jlc_lanes JerkLimitedFleet::lanes(int begin, int end){
+    double *b = data_ + begin;
+    const int n = stride_;
+    jlc_lanes l;
+    l.n = end - begin;
+    l.sm = b + SM*n;  l.vm = b + VM*n;  l.am = b + AM*n;  l.jm = b + JM*n;
+    l.kp = b + KP*n;  l.kv = b + KV*n;  l.ka = b + KA*n;
+    l.pos = b + U_POS*n;  l.vel = b + U_VEL*n;  l.acc = b + U_ACC*n;
+    l.POS = b + Y_POS*n;  l.VEL = b + Y_VEL*n;  l.ACC = b + Y_ACC*n;  l.JRK = b + Y_JRK*n;
+    l.q = b + X_Q*n;  l.v = b + X_V*n;  l.a = b + X_A*n;
+    l.dq = b + D_Q*n;  l.dv = b + D_V*n;  l.da = b + D_A*n;
+    return l;
+}
+
+void JerkLimitedFleet::step_chunk(int begin, int end, int n_steps){
+    const jlc_lanes l = lanes(begin, end);
+    for (int k=0; k<n_steps; k++)
+        jlc_step(l, step_size_, solver_, isa_);
+}
+
+
+void JerkLimitedFleet::step(int n_steps, int n_threads){
+    if (n_steps <= 0)
+        return;
+    if (n_threads <= 0)
+        n_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // chunks are multiples of 8 lanes (one AVX-512 vector, one cache line of every array), the threads do not
+    // share cache lines and only the last chunk is partial
+    const int block = 8;
+    const int n_blocks = (n_lanes_ + block - 1) / block;
+    n_threads = std::min(n_threads, n_blocks);
+
+    if (n_threads == 1) {
+        step_chunk(0, n_lanes_, n_steps);
+    }
+    else {
+        std::vector<std::thread> workers;
+        workers.reserve(n_threads - 1);
+        int begin = 0;
+        for (int t=0; t<n_threads; t++) {
+            const int blocks = n_blocks / n_threads + (t < n_blocks % n_threads ? 1 : 0);
+            const int end = std::min(n_lanes_, begin + blocks*block);
+            if (t == n_threads - 1)
+                step_chunk(begin, end, n_steps);  // the calling thread takes the last chunk
+            else
+                workers.push_back(std::thread(&JerkLimitedFleet::step_chunk, this, begin, end, n_steps));
+            begin = end;
+        }
+        for (size_t t=0; t<workers.size(); t++)
+            workers[t].join();
+    }
+    ticks_ += n_steps;
+}
@@ -0,0 +1,99 @@
+/**
+\file   jlc_fleet.h
+\brief  batch of many jerk limited controllers stepped together, for offline simulation of robot cells.
+ *
+ *  M controller instances with J joints each are stored in structure-of-arrays layout, one array per quantity
+ *  with J*M elements ordered joint by joint: lane(inst, jt) = jt*M + inst, so the vector lanes of the kernel
+ *  (jlc_simd_kernel.h) run across the instances of the same joint. every array starts on a cache line (64 bytes,
+ *  the arrays are padded to a multiple of 8 lanes).
+ *  the lanes do not depend on each other, so step() splits them in chunks over threads and every thread
+ *  advances its chunk by all the requested steps without synchronization, the inputs are held during the call.
+ *  every instance gives the same numbers as a JerkLimitedController with the same parameters and inputs.
+ *
+ *  usage:
+ *      JerkLimitedFleet fleet(1000, 6);
+ *      fleet.set_limits(sm, vm, am, jm);  fleet.set_gains(kp, kv, ka);
+ *      fleet.initialize();
+ *      fleet.pos()[fleet.lane(inst, jt)] = ...;  fleet.step(125, 4);  fleet.POS()[fleet.lane(inst, jt)] ...
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef JLC_FLEET_H
+#define JLC_FLEET_H
+
+#include <vector>
+#include "jlc_simd_kernel.h"
+
+
+class JerkLimitedFleet
+{
+public:
+    JerkLimitedFleet(int n_instances, int n_joints, double step_size = 0.008);
+    // the arrays point inside buf_, not copyable
+    JerkLimitedFleet(const JerkLimitedFleet&) = delete;
+    JerkLimitedFleet& operator=(const JerkLimitedFleet&) = delete;
+
+    int n_instances() const { return n_inst_; }
+    int n_joints() const { return n_jts_; }
+    int n_lanes() const { return n_lanes_; }
+    int lane(int inst, int jt) const { return jt*n_inst_ + inst; }
+
+    // same limits and gains for all instances, or for one instance
+    void set_limits(double sm, double vm, double am, double jm);
+    void set_gains(double kp, double kv, double ka);
+    void set_limits(int inst, double sm, double vm, double am, double jm);
+    void set_gains(int inst, double kp, double kv, double ka);
+
+    // reset states, inputs and outputs to zero
+    void initialize();
+    // advance all the instances by n_steps, using n_threads threads (0: one per core)
+    void step(int n_steps = 1, int n_threads = 1);
+
+    // integration mode, JLC_SOLVER_ODE3 by default
+    void set_solver(jlc_solver solver) { solver_ = solver; }
+    jlc_solver solver() const { return solver_; }
+
+    // instruction set of the kernel, the best one of the cpu by default
+    void set_isa(jlc_isa isa) { isa_ = isa; }
+    jlc_isa isa() const { return isa_; }
+
+    double step_size() const { return step_size_; }
+    double time() const { return ticks_*step_size_; }
+
+    // ---------- arrays of n_lanes() elements, indexed by lane() ----------
+    double* sm() { return data_ + SM*stride_; }
+    double* vm() { return data_ + VM*stride_; }
+    double* am() { return data_ + AM*stride_; }
+    double* jm() { return data_ + JM*stride_; }
+    double* kp() { return data_ + KP*stride_; }
+    double* kv() { return data_ + KV*stride_; }
+    double* ka() { return data_ + KA*stride_; }
+    double* pos() { return data_ + U_POS*stride_; }
+    double* vel() { return data_ + U_VEL*stride_; }
+    double* acc() { return data_ + U_ACC*stride_; }
+    const double* POS() const { return data_ + Y_POS*stride_; }
+    const double* VEL() const { return data_ + Y_VEL*stride_; }
+    const double* ACC() const { return data_ + Y_ACC*stride_; }
+    const double* JRK() const { return data_ + Y_JRK*stride_; }
+
+private:
+    // order of the arrays in data_
+    enum field { SM, VM, AM, JM, KP, KV, KA, U_POS, U_VEL, U_ACC, Y_POS, Y_VEL, Y_ACC, Y_JRK,
+                 X_Q, X_V, X_A, D_Q, D_V, D_A, N_FIELDS };
+
+    // kernel view of the lanes [begin, end)
+    jlc_lanes lanes(int begin, int end);
+    void step_chunk(int begin, int end, int n_steps);
+
+    int n_inst_, n_jts_, n_lanes_;
+    int stride_;                  // elements per array: n_lanes_ rounded up to 8, a multiple of the cache line
+    double step_size_;
+    unsigned long long ticks_;
+    jlc_solver solver_;
+    jlc_isa isa_;
+    std::vector<double> buf_;     // the arrays, with room to align the first one
+    double *data_;                // first cache line of buf_
+};
+
+#endif // JLC_FLEET_H
@@ -0,0 +1,251 @@
+/**
+\file   jlc_rk_kernels.cpp
+\brief  ODE1 (euler) and ODE4 (runge-kutta) steps of the jerk limited controller, see jlc_simd_kernel.h
+ *
+ *  same structure as the ODE3 kernel: the jerk is computed once from the delayed outputs, then the stages
+ *  only evaluate the derivatives (sat(v), sat(a), jrk), nothing else of the output path is re-run.
+ *  the outputs POS, VEL, ACC are the saturated states at the end of the step.
+ *  coefficients and summation order as in rt_ertODEUpdateContinuousStates of the simulink ode1/ode4 solvers.
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+// no fused multiply-add, so all the instruction sets give the same numbers (see jlc_simd_ops.h)
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize ("fp-contract=off")
+#endif
+
+#include "jlc_simd_ops.h"
+
+
+// ============================== scalar ==============================
+
+static void step_ode1_scalar(const jlc_lanes &l, double h, int begin){
+    for (int i=begin; i<l.n; i++) {
+        const double xq = l.q[i], xv = l.v[i], xa = l.a[i];
+        const double sm = l.sm[i], vm = l.vm[i], am = l.am[i];
+
+        const double y0q = sat(xq, sm), y0v = sat(xv, vm), y0a = sat(xa, am);
+        const double jrk = jerk_scalar(l, i);
+        l.JRK[i] = jrk;
+        l.dq[i] = y0q;
+        l.dv[i] = y0v;
+        l.da[i] = y0a;
+
+        const double q = xq + h*y0v, v = xv + h*y0a, a = xa + h*jrk;
+        l.q[i] = q;
+        l.v[i] = v;
+        l.a[i] = a;
+        l.POS[i] = sat(q, sm);
+        l.VEL[i] = sat(v, vm);
+        l.ACC[i] = sat(a, am);
+    }
+}
+
+static void step_ode4_scalar(const jlc_lanes &l, double h, int begin){
+    const double hh = h*0.5, h6 = h/6.0;
+    for (int i=begin; i<l.n; i++) {
+        const double xq = l.q[i], xv = l.v[i], xa = l.a[i];
+        const double sm = l.sm[i], vm = l.vm[i], am = l.am[i];
+
+        const double y0q = sat(xq, sm), y0v = sat(xv, vm), y0a = sat(xa, am);
+        const double jrk = jerk_scalar(l, i);
+        l.JRK[i] = jrk;
+        l.dq[i] = y0q;
+        l.dv[i] = y0v;
+        l.da[i] = y0a;
+
+        // derivatives of the stages: (sat(v), sat(a), jrk)
+        const double f1q = sat(xv + y0a*hh, vm), f1v = sat(xa + jrk*hh, am);
+        const double f2q = sat(xv + f1v*hh, vm), f2v = sat(xa + jrk*hh, am);
+        const double f3q = sat(xv + f2v*h, vm),  f3v = sat(xa + jrk*h, am);
+
+        const double q = xq + h6*(y0v + 2.0*f1q + 2.0*f2q + f3q);
+        const double v = xv + h6*(y0a + 2.0*f1v + 2.0*f2v + f3v);
+        const double a = xa + h6*(jrk + 2.0*jrk + 2.0*jrk + jrk);
+        l.q[i] = q;
+        l.v[i] = v;
+        l.a[i] = a;
+        l.POS[i] = sat(q, sm);
+        l.VEL[i] = sat(v, vm);
+        l.ACC[i] = sat(a, am);
+    }
+}
+
+
+#ifdef JLC_X86
+
+// ============================== AVX2 ==============================
+
+JLC_AVX2 static void step_ode1_avx2(const jlc_lanes &l, double step){
+    const __m256d h = _mm256_set1_pd(step);
+    int i = 0;
+    for (; i+4<=l.n; i+=4) {
+        const __m256d xq = _mm256_loadu_pd(l.q+i), xv = _mm256_loadu_pd(l.v+i), xa = _mm256_loadu_pd(l.a+i);
+        const __m256d sm = _mm256_loadu_pd(l.sm+i), vm = _mm256_loadu_pd(l.vm+i), am = _mm256_loadu_pd(l.am+i);
+
+        const __m256d y0q = sat_avx2(xq, sm), y0v = sat_avx2(xv, vm), y0a = sat_avx2(xa, am);
+        const __m256d jrk = jerk_avx2(l, i);
+        _mm256_storeu_pd(l.JRK+i, jrk);
+        _mm256_storeu_pd(l.dq+i, y0q);
+        _mm256_storeu_pd(l.dv+i, y0v);
+        _mm256_storeu_pd(l.da+i, y0a);
+
+        const __m256d q = _mm256_add_pd(xq, _mm256_mul_pd(h, y0v));
+        const __m256d v = _mm256_add_pd(xv, _mm256_mul_pd(h, y0a));
+        const __m256d a = _mm256_add_pd(xa, _mm256_mul_pd(h, jrk));
+        _mm256_storeu_pd(l.q+i, q);
+        _mm256_storeu_pd(l.v+i, v);
+        _mm256_storeu_pd(l.a+i, a);
+        _mm256_storeu_pd(l.POS+i, sat_avx2(q, sm));
+        _mm256_storeu_pd(l.VEL+i, sat_avx2(v, vm));
+        _mm256_storeu_pd(l.ACC+i, sat_avx2(a, am));
+    }
+    step_ode1_scalar(l, step, i);
+}
+
+// f0 + 2*f1 + 2*f2 + f3
+JLC_AVX2 static inline __m256d rk4_sum_avx2(__m256d f0, __m256d f1, __m256d f2, __m256d f3){
+    const __m256d two = _mm256_set1_pd(2.0);
+    return _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(f0, _mm256_mul_pd(two, f1)), _mm256_mul_pd(two, f2)), f3);
+}
+
+JLC_AVX2 static void step_ode4_avx2(const jlc_lanes &l, double step){
+    const __m256d h = _mm256_set1_pd(step), hh = _mm256_set1_pd(step*0.5), h6 = _mm256_set1_pd(step/6.0);
+    int i = 0;
+    for (; i+4<=l.n; i+=4) {
+        const __m256d xq = _mm256_loadu_pd(l.q+i), xv = _mm256_loadu_pd(l.v+i), xa = _mm256_loadu_pd(l.a+i);
+        const __m256d sm = _mm256_loadu_pd(l.sm+i), vm = _mm256_loadu_pd(l.vm+i), am = _mm256_loadu_pd(l.am+i);
+
+        const __m256d y0q = sat_avx2(xq, sm), y0v = sat_avx2(xv, vm), y0a = sat_avx2(xa, am);
+        const __m256d jrk = jerk_avx2(l, i);
+        _mm256_storeu_pd(l.JRK+i, jrk);
+        _mm256_storeu_pd(l.dq+i, y0q);
+        _mm256_storeu_pd(l.dv+i, y0v);
+        _mm256_storeu_pd(l.da+i, y0a);
+
+        const __m256d f1q = sat_avx2(_mm256_add_pd(xv, _mm256_mul_pd(y0a, hh)), vm);
+        const __m256d f1v = sat_avx2(_mm256_add_pd(xa, _mm256_mul_pd(jrk, hh)), am);
+        const __m256d f2q = sat_avx2(_mm256_add_pd(xv, _mm256_mul_pd(f1v, hh)), vm);
+        const __m256d f2v = sat_avx2(_mm256_add_pd(xa, _mm256_mul_pd(jrk, hh)), am);
+        const __m256d f3q = sat_avx2(_mm256_add_pd(xv, _mm256_mul_pd(f2v, h)), vm);
+        const __m256d f3v = sat_avx2(_mm256_add_pd(xa, _mm256_mul_pd(jrk, h)), am);
+
+        const __m256d q = _mm256_add_pd(xq, _mm256_mul_pd(h6, rk4_sum_avx2(y0v, f1q, f2q, f3q)));
+        const __m256d v = _mm256_add_pd(xv, _mm256_mul_pd(h6, rk4_sum_avx2(y0a, f1v, f2v, f3v)));
+        const __m256d a = _mm256_add_pd(xa, _mm256_mul_pd(h6, rk4_sum_avx2(jrk, jrk, jrk, jrk)));
+        _mm256_storeu_pd(l.q+i, q);
+        _mm256_storeu_pd(l.v+i, v);
+        _mm256_storeu_pd(l.a+i, a);
+        _mm256_storeu_pd(l.POS+i, sat_avx2(q, sm));
+        _mm256_storeu_pd(l.VEL+i, sat_avx2(v, vm));
+        _mm256_storeu_pd(l.ACC+i, sat_avx2(a, am));
+    }
+    step_ode4_scalar(l, step, i);
+}
+
+
+// ============================== AVX-512 ==============================
+
+JLC_AVX512 static void step_ode1_avx512(const jlc_lanes &l, double step){
+    const __m512d h = _mm512_set1_pd(step);
+    for (int i=0; i<l.n; i+=8) {
+        const __mmask8 m = tail_mask(i, l.n);
+        const __m512d xq = LD(l.q), xv = LD(l.v), xa = LD(l.a);
+        const __m512d sm = LD(l.sm), vm = LD(l.vm), am = LD(l.am);
+
+        const __m512d y0q = sat_avx512(xq, sm), y0v = sat_avx512(xv, vm), y0a = sat_avx512(xa, am);
+        const __m512d jrk = jerk_avx512(l, i, m);
+        ST(l.JRK, jrk);
+        ST(l.dq, y0q);
+        ST(l.dv, y0v);
+        ST(l.da, y0a);
+
+        const __m512d q = _mm512_add_pd(xq, _mm512_mul_pd(h, y0v));
+        const __m512d v = _mm512_add_pd(xv, _mm512_mul_pd(h, y0a));
+        const __m512d a = _mm512_add_pd(xa, _mm512_mul_pd(h, jrk));
+        ST(l.q, q);
+        ST(l.v, v);
+        ST(l.a, a);
+        ST(l.POS, sat_avx512(q, sm));
+        ST(l.VEL, sat_avx512(v, vm));
+        ST(l.ACC, sat_avx512(a, am));
+    }
+}
+
+JLC_AVX512 static inline __m512d rk4_sum_avx512(__m512d f0, __m512d f1, __m512d f2, __m512d f3){
+    const __m512d two = _mm512_set1_pd(2.0);
+    return _mm512_add_pd(_mm512_add_pd(_mm512_add_pd(f0, _mm512_mul_pd(two, f1)), _mm512_mul_pd(two, f2)), f3);
+}
+
+JLC_AVX512 static void step_ode4_avx512(const jlc_lanes &l, double step){
+    const __m512d h = _mm512_set1_pd(step), hh = _mm512_set1_pd(step*0.5), h6 = _mm512_set1_pd(step/6.0);
+    for (int i=0; i<l.n; i+=8) {
+        const __mmask8 m = tail_mask(i, l.n);
+        const __m512d xq = LD(l.q), xv = LD(l.v), xa = LD(l.a);
+        const __m512d sm = LD(l.sm), vm = LD(l.vm), am = LD(l.am);
+
+        const __m512d y0q = sat_avx512(xq, sm), y0v = sat_avx512(xv, vm), y0a = sat_avx512(xa, am);
+        const __m512d jrk = jerk_avx512(l, i, m);
+        ST(l.JRK, jrk);
+        ST(l.dq, y0q);
+        ST(l.dv, y0v);
+        ST(l.da, y0a);
+
+        const __m512d f1q = sat_avx512(_mm512_add_pd(xv, _mm512_mul_pd(y0a, hh)), vm);
+        const __m512d f1v = sat_avx512(_mm512_add_pd(xa, _mm512_mul_pd(jrk, hh)), am);
+        const __m512d f2q = sat_avx512(_mm512_add_pd(xv, _mm512_mul_pd(f1v, hh)), vm);
+        const __m512d f2v = sat_avx512(_mm512_add_pd(xa, _mm512_mul_pd(jrk, hh)), am);
+        const __m512d f3q = sat_avx512(_mm512_add_pd(xv, _mm512_mul_pd(f2v, h)), vm);
+        const __m512d f3v = sat_avx512(_mm512_add_pd(xa, _mm512_mul_pd(jrk, h)), am);
+
+        const __m512d q = _mm512_add_pd(xq, _mm512_mul_pd(h6, rk4_sum_avx512(y0v, f1q, f2q, f3q)));
+        const __m512d v = _mm512_add_pd(xv, _mm512_mul_pd(h6, rk4_sum_avx512(y0a, f1v, f2v, f3v)));
+        const __m512d a = _mm512_add_pd(xa, _mm512_mul_pd(h6, rk4_sum_avx512(jrk, jrk, jrk, jrk)));
+        ST(l.q, q);
+        ST(l.v, v);
+        ST(l.a, a);
+        ST(l.POS, sat_avx512(q, sm));
+        ST(l.VEL, sat_avx512(v, vm));
+        ST(l.ACC, sat_avx512(a, am));
+    }
+}
+
+#endif // JLC_X86
+
+
+// ============================== dispatch ==============================
+
+void jlc_step_ode1(const jlc_lanes &l, double h, jlc_isa isa){
+    if (isa > jlc_best_isa())
+        isa = jlc_best_isa();
+#ifdef JLC_X86
+    if (isa == JLC_ISA_AVX512) {
+        step_ode1_avx512(l, h);
+        return;
+    }
+    if (isa == JLC_ISA_AVX2) {
+        step_ode1_avx2(l, h);
+        return;
+    }
+#endif
+    step_ode1_scalar(l, h, 0);
+}
+
+void jlc_step_ode4(const jlc_lanes &l, double h, jlc_isa isa){
+    if (isa > jlc_best_isa())
+        isa = jlc_best_isa();
+#ifdef JLC_X86
+    if (isa == JLC_ISA_AVX512) {
+        step_ode4_avx512(l, h);
+        return;
+    }
+    if (isa == JLC_ISA_AVX2) {
+        step_ode4_avx2(l, h);
+        return;
+    }
+#endif
+    step_ode4_scalar(l, h, 0);
+}
@@ -0,0 +1,570 @@
+/**
+\file   jlc_simd_kernel.cpp
+\brief  scalar, AVX2 and AVX-512 versions of the jerk limited controller step, see jlc_simd_kernel.h
+ *
+ *  the three versions do the same operations in the same order:
+ *      y0 = sat(x)                      outputs at the start of the step
+ *      jrk = sat(((pos-dq)*kp + (vel-dv)*kv) + (acc-da)*ka, jm),  d = y0
+ *      ODE3 stages with the derivatives (VEL, ACC, jrk) of the saturated stage outputs,
+ *      the outputs POS, VEL, ACC are the ones of the last stage (like the simulink models).
+ *  the exact versions compute the closed form of the step for all the lanes (acc and vel inside or beyond
+ *  their limits for the whole step), the lanes where acc or vel cross a limit during the step are then redone
+ *  one by one with the piecewise integration.
+ *  the vector versions are compiled with the target attribute, so the rest of the package does not need
+ *  -mavx2 and the binary still runs on older cpus.
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+// avx512f also enables FMA instructions, a fused multiply-add rounds once and would change the results,
+// keep every multiply and add separate like the simulink code
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize ("fp-contract=off")
+#endif
+
+#include "jlc_simd_ops.h"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+
+
+// ODE3 (Bogacki-Shampine) coefficients times h, as in rt_ertODEUpdateContinuousStates
+struct ode3_coef {
+    double b0, c0, c1, d0, d1, d2;
+    explicit ode3_coef(double h){
+        b0 = h*(1.0/2.0);
+        c0 = h*0.0;
+        c1 = h*(3.0/4.0);
+        d0 = h*(2.0/9.0);
+        d1 = h*(1.0/3.0);
+        d2 = h*(4.0/9.0);
+    }
+};
+
+
+// ============================== ODE3, scalar ==============================
+
+static void step_scalar(const jlc_lanes &l, const ode3_coef &k, int begin){
+    for (int i=begin; i<l.n; i++) {
+        const double xq = l.q[i], xv = l.v[i], xa = l.a[i];
+        const double sm = l.sm[i], vm = l.vm[i], am = l.am[i];
+
+        // outputs of the states, jerk from the delayed outputs
+        const double y0q = sat(xq, sm), y0v = sat(xv, vm), y0a = sat(xa, am);
+        const double jrk = jerk_scalar(l, i);
+        l.JRK[i] = jrk;
+        l.dq[i] = y0q;
+        l.dv[i] = y0v;
+        l.da[i] = y0a;
+
+        // stage 1
+        const double y1v = sat(xv + y0a*k.b0, vm);
+        const double y1a = sat(xa + jrk*k.b0, am);
+        // stage 2
+        const double y2q = sat(xq + (y0v*k.c0 + y1v*k.c1), sm);
+        const double y2v = sat(xv + (y0a*k.c0 + y1a*k.c1), vm);
+        const double y2a = sat(xa + (jrk*k.c0 + jrk*k.c1), am);
+        // new states
+        l.q[i] = xq + (y0v*k.d0 + y1v*k.d1 + y2v*k.d2);
+        l.v[i] = xv + (y0a*k.d0 + y1a*k.d1 + y2a*k.d2);
+        l.a[i] = xa + (jrk*k.d0 + jrk*k.d1 + jrk*k.d2);
+
+        l.POS[i] = y2q;
+        l.VEL[i] = y2v;
+        l.ACC[i] = y2a;
+    }
+}
+
+
+// ============================== exact, scalar ==============================
+
+// powers of h for the closed form propagation
+struct exact_coef {
+    double h, h2_2, h3_6;
+    explicit exact_coef(double step){
+        h = step;
+        h2_2 = step*step/2.0;
+        h3_6 = step*step*step/6.0;
+    }
+};
+
+// real roots of c2*s^2 + c1*s + c0 = 0 inside (0, T), returns how many were added to r
+static int roots_in(double c2, double c1, double c0, double T, double *r){
+    int n = 0;
+    if (c2 == 0) {
+        if (c1 != 0) {
+            const double s = -c0/c1;
+            if (s > 0 && s < T)
+                r[n++] = s;
+        }
+        return n;
+    }
+    const double disc = c1*c1 - 4*c2*c0;
+    if (disc < 0)
+        return 0;
+    // numerically stable form of the two roots
+    const double qq = -0.5*(c1 + (c1 >= 0 ? sqrt(disc) : -sqrt(disc)));
+    const double s1 = qq/c2;
+    const double s2 = qq != 0 ? c0/qq : s1;
+    if (s1 > 0 && s1 < T)
+        r[n++] = s1;
+    if (s2 > 0 && s2 < T && s2 != s1)
+        r[n++] = s2;
+    return n;
+}
+
+// integral over [0, T] of sat(p(s), lim) with p(s) = p0 + p1*s + p2*s^2
+static double integral_sat_poly(double p0, double p1, double p2, double T, double lim){
+    double bp[5];
+    int n = roots_in(p2, p1, p0 - lim, T, bp);
+    n += roots_in(p2, p1, p0 + lim, T, bp + n);
+    for (int a=1; a<n; a++)  // at most 4 roots, insertion sort
+        for (int b=a; b>0 && bp[b-1] > bp[b]; b--)
+            std::swap(bp[b-1], bp[b]);
+    bp[n++] = T;
+
+    double sum = 0, s0 = 0;
+    for (int k=0; k<n; k++) {
+        const double s1 = bp[k];
+        const double sm = 0.5*(s0 + s1);
+        const double pm = p0 + p1*sm + p2*sm*sm;
+        if (pm > lim)
+            sum += lim*(s1 - s0);
+        else if (pm < -lim)
+            sum -= lim*(s1 - s0);
+        else
+            sum += (p0*s1 + p1*s1*s1/2.0 + p2*s1*s1*s1/3.0) - (p0*s0 + p1*s0*s0/2.0 + p2*s0*s0*s0/3.0);
+        s0 = s1;
+    }
+    return sum;
+}
+
+// closed form when the saturation of acc and vel does not change during the step:
+// acc inside its limits for the whole step, or beyond the same limit (then vel moves with +-am),
+// vel inside its limits (monotonic, or with its extremum v - a^2/(2j) inside too) or beyond the same limit.
+// returns false when a limit is crossed during the step, then integrate_exact is needed
+static inline bool exact_closed_form(double &q, double &v, double &a, double j, const exact_coef &k,
+                                     double vm, double am){
+    const double a1 = a + j*k.h;
+    const bool a_in = a <= am && a >= -am && a1 <= am && a1 >= -am;
+    double dv, dq;
+    if (a_in) {
+        dv = a*k.h + j*k.h2_2;
+        dq = a*k.h2_2 + j*k.h3_6;
+    }
+    else if (a >= am && a1 >= am) {
+        dv = am*k.h;
+        dq = am*k.h2_2;
+    }
+    else if (a <= -am && a1 <= -am) {
+        dv = (-am)*k.h;
+        dq = (-am)*k.h2_2;
+    }
+    else
+        return false;
+
+    const double v1 = v + dv;
+    const bool mono = !a_in || a*a1 >= 0;
+    const double v_ext = v - a*a/(2.0*j);
+    double q1;
+    if (v <= vm && v >= -vm && v1 <= vm && v1 >= -vm && (mono || (v_ext <= vm && v_ext >= -vm)))
+        q1 = q + (v*k.h + dq);
+    else if (mono && v >= vm && v1 >= vm)
+        q1 = q + vm*k.h;
+    else if (mono && v <= -vm && v1 <= -vm)
+        q1 = q + (-vm)*k.h;
+    else
+        return false;
+    q = q1;
+    v = v1;
+    a = a1;
+    return true;
+}
+
+// general case: split the step where a crosses +-am, inside each piece v is a polynomial of degree <= 2
+// and the integral of sat(v) is split again where v crosses +-vm
+static void integrate_exact(double &q, double &v, double &a, double j, double h, double vm, double am){
+    double bp[3];
+    int n = 0;
+    if (j != 0) {
+        const double t1 = (am - a)/j, t2 = (-am - a)/j;
+        if (t1 > 0 && t1 < h)
+            bp[n++] = t1;
+        if (t2 > 0 && t2 < h)
+            bp[n++] = t2;
+        if (n == 2 && bp[0] > bp[1])
+            std::swap(bp[0], bp[1]);
+    }
+    bp[n++] = h;
+
+    double t0 = 0;
+    for (int k=0; k<n; k++) {
+        const double T = bp[k] - t0;
+        const double am_mid = a + j*(t0 + 0.5*T);
+        double c1, c2;  // v(s) = v + c1*s + c2*s^2 in this piece
+        if (am_mid > am) {
+            c1 = am;  c2 = 0;
+        }
+        else if (am_mid < -am) {
+            c1 = -am;  c2 = 0;
+        }
+        else {
+            c1 = a + j*t0;  c2 = j/2.0;
+        }
+        q += integral_sat_poly(v, c1, c2, T, vm);
+        v += c1*T + c2*T*T;
+        t0 = bp[k];
+    }
+    a += j*h;
+}
+
+static void step_exact_scalar(const jlc_lanes &l, const exact_coef &k, int begin){
+    for (int i=begin; i<l.n; i++) {
+        const double xq = l.q[i], xv = l.v[i], xa = l.a[i];
+        const double sm = l.sm[i], vm = l.vm[i], am = l.am[i];
+
+        const double jrk = jerk_scalar(l, i);
+        l.JRK[i] = jrk;
+        l.dq[i] = sat(xq, sm);
+        l.dv[i] = sat(xv, vm);
+        l.da[i] = sat(xa, am);
+
+        double q = xq, v = xv, a = xa;
+        if (!exact_closed_form(q, v, a, jrk, k, vm, am))
+            integrate_exact(q, v, a, jrk, k.h, vm, am);
+        l.q[i] = q;
+        l.v[i] = v;
+        l.a[i] = a;
+
+        l.POS[i] = sat(q, sm);
+        l.VEL[i] = sat(v, vm);
+        l.ACC[i] = sat(a, am);
+    }
+}
+
+// redo the lanes of a vector block that left the fast path, x* hold the states at the start of the step
+static void exact_slow_lanes(const jlc_lanes &l, const exact_coef &k, int i, unsigned slow,
+                             const double *xq, const double *xv, const double *xa){
+    for (int b=0; slow; b++, slow >>= 1) {
+        if (!(slow & 1u))
+            continue;
+        double q = xq[b], v = xv[b], a = xa[b];
+        integrate_exact(q, v, a, l.JRK[i+b], k.h, l.vm[i+b], l.am[i+b]);
+        l.q[i+b] = q;
+        l.v[i+b] = v;
+        l.a[i+b] = a;
+        l.POS[i+b] = sat(q, l.sm[i+b]);
+        l.VEL[i+b] = sat(v, l.vm[i+b]);
+        l.ACC[i+b] = sat(a, l.am[i+b]);
+    }
+}
+
+
+#ifdef JLC_X86
+
+// ============================== AVX2 (ODE3 and exact) ==============================
+
+JLC_AVX2 static void step_avx2(const jlc_lanes &l, const ode3_coef &k){
+    const __m256d b0 = _mm256_set1_pd(k.b0), c0 = _mm256_set1_pd(k.c0), c1 = _mm256_set1_pd(k.c1);
+    const __m256d d0 = _mm256_set1_pd(k.d0), d1 = _mm256_set1_pd(k.d1), d2 = _mm256_set1_pd(k.d2);
+    int i = 0;
+    for (; i+4<=l.n; i+=4) {
+        const __m256d xq = _mm256_loadu_pd(l.q+i), xv = _mm256_loadu_pd(l.v+i), xa = _mm256_loadu_pd(l.a+i);
+        const __m256d sm = _mm256_loadu_pd(l.sm+i), vm = _mm256_loadu_pd(l.vm+i), am = _mm256_loadu_pd(l.am+i);
+
+        const __m256d y0q = sat_avx2(xq, sm), y0v = sat_avx2(xv, vm), y0a = sat_avx2(xa, am);
+        const __m256d jrk = jerk_avx2(l, i);
+        _mm256_storeu_pd(l.JRK+i, jrk);
+        _mm256_storeu_pd(l.dq+i, y0q);
+        _mm256_storeu_pd(l.dv+i, y0v);
+        _mm256_storeu_pd(l.da+i, y0a);
+
+        const __m256d y1v = sat_avx2(_mm256_add_pd(xv, _mm256_mul_pd(y0a, b0)), vm);
+        const __m256d y1a = sat_avx2(_mm256_add_pd(xa, _mm256_mul_pd(jrk, b0)), am);
+
+        const __m256d y2q = sat_avx2(_mm256_add_pd(xq, _mm256_add_pd(_mm256_mul_pd(y0v, c0), _mm256_mul_pd(y1v, c1))), sm);
+        const __m256d y2v = sat_avx2(_mm256_add_pd(xv, _mm256_add_pd(_mm256_mul_pd(y0a, c0), _mm256_mul_pd(y1a, c1))), vm);
+        const __m256d y2a = sat_avx2(_mm256_add_pd(xa, _mm256_add_pd(_mm256_mul_pd(jrk, c0), _mm256_mul_pd(jrk, c1))), am);
+
+        _mm256_storeu_pd(l.q+i, _mm256_add_pd(xq, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(y0v, d0), _mm256_mul_pd(y1v, d1)), _mm256_mul_pd(y2v, d2))));
+        _mm256_storeu_pd(l.v+i, _mm256_add_pd(xv, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(y0a, d0), _mm256_mul_pd(y1a, d1)), _mm256_mul_pd(y2a, d2))));
+        _mm256_storeu_pd(l.a+i, _mm256_add_pd(xa, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(jrk, d0), _mm256_mul_pd(jrk, d1)), _mm256_mul_pd(jrk, d2))));
+
+        _mm256_storeu_pd(l.POS+i, y2q);
+        _mm256_storeu_pd(l.VEL+i, y2v);
+        _mm256_storeu_pd(l.ACC+i, y2a);
+    }
+    // less than 4 lanes left
+    step_scalar(l, k, i);
+}
+
+
+JLC_AVX2 static void step_exact_avx2(const jlc_lanes &l, const exact_coef &k){
+    const __m256d h = _mm256_set1_pd(k.h), h2_2 = _mm256_set1_pd(k.h2_2), h3_6 = _mm256_set1_pd(k.h3_6);
+    const __m256d zero = _mm256_setzero_pd(), two = _mm256_set1_pd(2.0), neg = _mm256_set1_pd(-0.0);
+    int i = 0;
+    for (; i+4<=l.n; i+=4) {
+        const __m256d xq = _mm256_loadu_pd(l.q+i), xv = _mm256_loadu_pd(l.v+i), xa = _mm256_loadu_pd(l.a+i);
+        const __m256d sm = _mm256_loadu_pd(l.sm+i), vm = _mm256_loadu_pd(l.vm+i), am = _mm256_loadu_pd(l.am+i);
+        const __m256d nvm = _mm256_xor_pd(vm, neg), nam = _mm256_xor_pd(am, neg);
+
+        const __m256d jrk = jerk_avx2(l, i);
+        _mm256_storeu_pd(l.JRK+i, jrk);
+        _mm256_storeu_pd(l.dq+i, sat_avx2(xq, sm));
+        _mm256_storeu_pd(l.dv+i, sat_avx2(xv, vm));
+        _mm256_storeu_pd(l.da+i, sat_avx2(xa, am));
+
+        // acc inside, above or below its limits for the whole step (see exact_closed_form)
+        const __m256d a = _mm256_add_pd(xa, _mm256_mul_pd(jrk, h));
+        const __m256d a_in = _mm256_and_pd(inside_avx2(xa, am), inside_avx2(a, am));
+        const __m256d a_hi = _mm256_and_pd(_mm256_cmp_pd(xa, am, _CMP_GE_OQ), _mm256_cmp_pd(a, am, _CMP_GE_OQ));
+        const __m256d a_lo = _mm256_and_pd(_mm256_cmp_pd(xa, nam, _CMP_LE_OQ), _mm256_cmp_pd(a, nam, _CMP_LE_OQ));
+        const __m256d c = _mm256_blendv_pd(nam, am, a_hi);
+        const __m256d dv = _mm256_blendv_pd(_mm256_mul_pd(c, h),
+                                            _mm256_add_pd(_mm256_mul_pd(xa, h), _mm256_mul_pd(jrk, h2_2)), a_in);
+        const __m256d dq = _mm256_blendv_pd(_mm256_mul_pd(c, h2_2),
+                                            _mm256_add_pd(_mm256_mul_pd(xa, h2_2), _mm256_mul_pd(jrk, h3_6)), a_in);
+
+        // vel inside, above or below its limits for the whole step
+        const __m256d v = _mm256_add_pd(xv, dv);
+        const __m256d mono = _mm256_or_pd(_mm256_andnot_pd(a_in, _mm256_castsi256_pd(_mm256_set1_epi64x(-1))),
+                                          _mm256_cmp_pd(_mm256_mul_pd(xa, a), zero, _CMP_GE_OQ));
+        const __m256d v_ext = _mm256_sub_pd(xv, _mm256_div_pd(_mm256_mul_pd(xa, xa), _mm256_mul_pd(two, jrk)));
+        const __m256d v_in = _mm256_and_pd(_mm256_and_pd(inside_avx2(xv, vm), inside_avx2(v, vm)),
+                                           _mm256_or_pd(mono, inside_avx2(v_ext, vm)));
+        const __m256d v_hi = _mm256_and_pd(mono, _mm256_and_pd(_mm256_cmp_pd(xv, vm, _CMP_GE_OQ), _mm256_cmp_pd(v, vm, _CMP_GE_OQ)));
+        const __m256d v_lo = _mm256_and_pd(mono, _mm256_and_pd(_mm256_cmp_pd(xv, nvm, _CMP_LE_OQ), _mm256_cmp_pd(v, nvm, _CMP_LE_OQ)));
+        const __m256d q = _mm256_blendv_pd(_mm256_add_pd(xq, _mm256_mul_pd(_mm256_blendv_pd(nvm, vm, v_hi), h)),
+                                           _mm256_add_pd(xq, _mm256_add_pd(_mm256_mul_pd(xv, h), dq)), v_in);
+
+        _mm256_storeu_pd(l.q+i, q);
+        _mm256_storeu_pd(l.v+i, v);
+        _mm256_storeu_pd(l.a+i, a);
+        _mm256_storeu_pd(l.POS+i, sat_avx2(q, sm));
+        _mm256_storeu_pd(l.VEL+i, sat_avx2(v, vm));
+        _mm256_storeu_pd(l.ACC+i, sat_avx2(a, am));
+
+        const __m256d fast = _mm256_and_pd(_mm256_or_pd(a_in, _mm256_or_pd(a_hi, a_lo)),
+                                           _mm256_or_pd(v_in, _mm256_or_pd(v_hi, v_lo)));
+        const unsigned slow = ~(unsigned)_mm256_movemask_pd(fast) & 0xFu;
+        if (slow) {
+            double bq[4], bv[4], ba[4];
+            _mm256_storeu_pd(bq, xq);
+            _mm256_storeu_pd(bv, xv);
+            _mm256_storeu_pd(ba, xa);
+            exact_slow_lanes(l, k, i, slow, bq, bv, ba);
+        }
+    }
+    step_exact_scalar(l, k, i);
+}
+
+
+// ============================== AVX-512 (ODE3 and exact) ==============================
+
+JLC_AVX512 static void step_avx512(const jlc_lanes &l, const ode3_coef &k){
+    const __m512d b0 = _mm512_set1_pd(k.b0), c0 = _mm512_set1_pd(k.c0), c1 = _mm512_set1_pd(k.c1);
+    const __m512d d0 = _mm512_set1_pd(k.d0), d1 = _mm512_set1_pd(k.d1), d2 = _mm512_set1_pd(k.d2);
+    for (int i=0; i<l.n; i+=8) {
+        const __mmask8 m = tail_mask(i, l.n);
+
+        const __m512d xq = LD(l.q), xv = LD(l.v), xa = LD(l.a);
+        const __m512d sm = LD(l.sm), vm = LD(l.vm), am = LD(l.am);
+
+        const __m512d y0q = sat_avx512(xq, sm), y0v = sat_avx512(xv, vm), y0a = sat_avx512(xa, am);
+        const __m512d jrk = jerk_avx512(l, i, m);
+        ST(l.JRK, jrk);
+        ST(l.dq, y0q);
+        ST(l.dv, y0v);
+        ST(l.da, y0a);
+
+        const __m512d y1v = sat_avx512(_mm512_add_pd(xv, _mm512_mul_pd(y0a, b0)), vm);
+        const __m512d y1a = sat_avx512(_mm512_add_pd(xa, _mm512_mul_pd(jrk, b0)), am);
+
+        const __m512d y2q = sat_avx512(_mm512_add_pd(xq, _mm512_add_pd(_mm512_mul_pd(y0v, c0), _mm512_mul_pd(y1v, c1))), sm);
+        const __m512d y2v = sat_avx512(_mm512_add_pd(xv, _mm512_add_pd(_mm512_mul_pd(y0a, c0), _mm512_mul_pd(y1a, c1))), vm);
+        const __m512d y2a = sat_avx512(_mm512_add_pd(xa, _mm512_add_pd(_mm512_mul_pd(jrk, c0), _mm512_mul_pd(jrk, c1))), am);
+
+        ST(l.q, _mm512_add_pd(xq, _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(y0v, d0), _mm512_mul_pd(y1v, d1)), _mm512_mul_pd(y2v, d2))));
+        ST(l.v, _mm512_add_pd(xv, _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(y0a, d0), _mm512_mul_pd(y1a, d1)), _mm512_mul_pd(y2a, d2))));
+        ST(l.a, _mm512_add_pd(xa, _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(jrk, d0), _mm512_mul_pd(jrk, d1)), _mm512_mul_pd(jrk, d2))));
+
+        ST(l.POS, y2q);
+        ST(l.VEL, y2v);
+        ST(l.ACC, y2a);
+    }
+}
+
+JLC_AVX512 static void step_exact_avx512(const jlc_lanes &l, const exact_coef &k){
+    const __m512d h = _mm512_set1_pd(k.h), h2_2 = _mm512_set1_pd(k.h2_2), h3_6 = _mm512_set1_pd(k.h3_6);
+    const __m512d zero = _mm512_setzero_pd(), two = _mm512_set1_pd(2.0);
+    for (int i=0; i<l.n; i+=8) {
+        const __mmask8 m = tail_mask(i, l.n);
+
+        const __m512d xq = LD(l.q), xv = LD(l.v), xa = LD(l.a);
+        const __m512d sm = LD(l.sm), vm = LD(l.vm), am = LD(l.am);
+        const __m512d nvm = neg_avx512(vm), nam = neg_avx512(am);
+
+        const __m512d jrk = jerk_avx512(l, i, m);
+        ST(l.JRK, jrk);
+        ST(l.dq, sat_avx512(xq, sm));
+        ST(l.dv, sat_avx512(xv, vm));
+        ST(l.da, sat_avx512(xa, am));
+
+        // acc inside, above or below its limits for the whole step (see exact_closed_form)
+        const __m512d a = _mm512_add_pd(xa, _mm512_mul_pd(jrk, h));
+        const __mmask8 a_in = inside_avx512(xa, am) & inside_avx512(a, am);
+        const __mmask8 a_hi = _mm512_cmp_pd_mask(xa, am, _CMP_GE_OQ) & _mm512_cmp_pd_mask(a, am, _CMP_GE_OQ);
+        const __mmask8 a_lo = _mm512_cmp_pd_mask(xa, nam, _CMP_LE_OQ) & _mm512_cmp_pd_mask(a, nam, _CMP_LE_OQ);
+        const __m512d c = _mm512_mask_blend_pd(a_hi, nam, am);
+        const __m512d dv = _mm512_mask_blend_pd(a_in, _mm512_mul_pd(c, h),
+                                                _mm512_add_pd(_mm512_mul_pd(xa, h), _mm512_mul_pd(jrk, h2_2)));
+        const __m512d dq = _mm512_mask_blend_pd(a_in, _mm512_mul_pd(c, h2_2),
+                                                _mm512_add_pd(_mm512_mul_pd(xa, h2_2), _mm512_mul_pd(jrk, h3_6)));
+
+        // vel inside, above or below its limits for the whole step
+        const __m512d v = _mm512_add_pd(xv, dv);
+        const __mmask8 mono = (__mmask8)(~a_in) | _mm512_cmp_pd_mask(_mm512_mul_pd(xa, a), zero, _CMP_GE_OQ);
+        const __m512d v_ext = _mm512_sub_pd(xv, _mm512_div_pd(_mm512_mul_pd(xa, xa), _mm512_mul_pd(two, jrk)));
+        const __mmask8 v_in = inside_avx512(xv, vm) & inside_avx512(v, vm) & (mono | inside_avx512(v_ext, vm));
+        const __mmask8 v_hi = mono & _mm512_cmp_pd_mask(xv, vm, _CMP_GE_OQ) & _mm512_cmp_pd_mask(v, vm, _CMP_GE_OQ);
+        const __mmask8 v_lo = mono & _mm512_cmp_pd_mask(xv, nvm, _CMP_LE_OQ) & _mm512_cmp_pd_mask(v, nvm, _CMP_LE_OQ);
+        const __m512d q = _mm512_mask_blend_pd(v_in, _mm512_add_pd(xq, _mm512_mul_pd(_mm512_mask_blend_pd(v_hi, nvm, vm), h)),
+                                               _mm512_add_pd(xq, _mm512_add_pd(_mm512_mul_pd(xv, h), dq)));
+
+        ST(l.q, q);
+        ST(l.v, v);
+        ST(l.a, a);
+        ST(l.POS, sat_avx512(q, sm));
+        ST(l.VEL, sat_avx512(v, vm));
+        ST(l.ACC, sat_avx512(a, am));
+
+        const __mmask8 fast = (a_in | a_hi | a_lo) & (v_in | v_hi | v_lo);
+        const unsigned slow = (unsigned)(m & ~fast);
+        if (slow) {
+            double bq[8], bv[8], ba[8];
+            _mm512_storeu_pd(bq, xq);
+            _mm512_storeu_pd(bv, xv);
+            _mm512_storeu_pd(ba, xa);
+            exact_slow_lanes(l, k, i, slow, bq, bv, ba);
+        }
+    }
+}
+
+#endif // JLC_X86
+
+
+// ============================== dispatch ==============================
+
+static jlc_isa detect_isa(){
+#ifdef JLC_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return JLC_ISA_AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return JLC_ISA_AVX2;
+#endif
+    return JLC_ISA_SCALAR;
+}
+
+jlc_isa jlc_best_isa(){
+    static const jlc_isa best = detect_isa();
+    return best;
+}
+
+const char* jlc_isa_name(jlc_isa isa){
+    switch (isa) {
+    case JLC_ISA_AVX512: return "avx512f";
+    case JLC_ISA_AVX2:   return "avx2";
+    default:             return "scalar";
+    }
+}
+
+void jlc_step_ode3(const jlc_lanes &l, double h){
+    jlc_step_ode3(l, h, jlc_best_isa());
+}
+
+void jlc_step_ode3(const jlc_lanes &l, double h, jlc_isa isa){
+    const ode3_coef k(h);
+    if (isa > jlc_best_isa())
+        isa = jlc_best_isa();
+#ifdef JLC_X86
+    if (isa == JLC_ISA_AVX512) {
+        step_avx512(l, k);
+        return;
+    }
+    if (isa == JLC_ISA_AVX2) {
+        step_avx2(l, k);
+        return;
+    }
+#endif
+    step_scalar(l, k, 0);
+}
+
+void jlc_step_exact(const jlc_lanes &l, double h){
+    jlc_step_exact(l, h, jlc_best_isa());
+}
+
+void jlc_step_exact(const jlc_lanes &l, double h, jlc_isa isa){
+    const exact_coef k(h);
+    if (isa > jlc_best_isa())
+        isa = jlc_best_isa();
+#ifdef JLC_X86
+    if (isa == JLC_ISA_AVX512) {
+        step_exact_avx512(l, k);
+        return;
+    }
+    if (isa == JLC_ISA_AVX2) {
+        step_exact_avx2(l, k);
+        return;
+    }
+#endif
+    step_exact_scalar(l, k, 0);
+}
+
+
+// adapters with the jlc_step_fn signature
+static void step_ode3_fn(const jlc_lanes &l, double h, jlc_isa isa){ jlc_step_ode3(l, h, isa); }
+static void step_exact_fn(const jlc_lanes &l, double h, jlc_isa isa){ jlc_step_exact(l, h, isa); }
+
+// indexed by jlc_solver
+static const struct {
+    const char *name;
+    jlc_step_fn step;
+} solvers[JLC_N_SOLVERS] = {
+    {"ode3",  step_ode3_fn},
+    {"exact", step_exact_fn},
+    {"ode1",  jlc_step_ode1},
+    {"ode4",  jlc_step_ode4}
+};
+
+jlc_step_fn jlc_solver_step_fn(jlc_solver solver){
+    if (solver < 0 || solver >= JLC_N_SOLVERS)
+        solver = JLC_SOLVER_ODE3;
+    return solvers[solver].step;
+}
+
+const char* jlc_solver_name(jlc_solver solver){
+    if (solver < 0 || solver >= JLC_N_SOLVERS)
+        return "unknown";
+    return solvers[solver].name;
+}
+
+bool jlc_solver_from_name(const char *name, jlc_solver &solver){
+    for (int s=0; s<JLC_N_SOLVERS; s++) {
+        if (strcmp(name, solvers[s].name) == 0) {
+            solver = (jlc_solver)s;
+            return true;
+        }
+    }
+    return false;
+}
+
+void jlc_step(const jlc_lanes &l, double h, jlc_solver solver){
+    jlc_step(l, h, solver, jlc_best_isa());
+}
+
+void jlc_step(const jlc_lanes &l, double h, jlc_solver solver, jlc_isa isa){
+    jlc_solver_step_fn(solver)(l, h, isa);
+}
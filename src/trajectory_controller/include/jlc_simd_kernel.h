@@ -0,0 +1,85 @@
+/**
+\file   jlc_simd_kernel.h
+\brief  vectorized step of the jerk limited controller on structure-of-arrays data.
+ *
+ *  every joint is one lane: the parameters, inputs, outputs and states are stored as separate arrays
+ *  (sm[], vm[], ..., q[], v[], a[]) so the same operation is applied to 4 (AVX2) or 8 (AVX-512) joints at once.
+ *  jlc_step_ode3 runs one major step for all the lanes: saturate the states, compute the jerk (kp/kv/ka error sum
+ *  limited by jm) and integrate with the ODE3 solver. it gives the same numbers as the scalar code of
+ *  JerkLimitedController (no FMA, same evaluation order).
+ *  jlc_step_exact is the other integration mode: the jerk is constant during a step, so the chain
+ *  jrk -> acc -> vel -> pos is propagated as exact polynomials, split where acc or vel cross their limits,
+ *  the outputs are the saturated states at the end of the step. it buys accuracy, not speed: the jerk is
+ *  evaluated once per step in both modes, and the closed form with its limit tests costs as much as the ODE3
+ *  stages or a bit more (and more than ode1).
+ *  jlc_step_ode1 / jlc_step_ode4 are the euler and runge-kutta solvers, their stages only evaluate the
+ *  derivatives and the outputs are the saturated states at the end of the step too.
+ *  src/solver_benchmark.cpp compares cost and accuracy of the solvers.
+ *  the instruction set is selected at run time (avx512f, avx2 or scalar), the last lanes that do not fill a
+ *  vector are handled with masked loads/stores, so the arrays need no padding.
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef JLC_SIMD_KERNEL_H
+#define JLC_SIMD_KERNEL_H
+
+
+enum jlc_isa {
+    JLC_ISA_SCALAR = 0,
+    JLC_ISA_AVX2   = 1,
+    JLC_ISA_AVX512 = 2
+};
+
+// integration of the continuous states during a step
+enum jlc_solver {
+    JLC_SOLVER_ODE3  = 0,   // fixed step Bogacki-Shampine, same results as the simulink models
+    JLC_SOLVER_EXACT = 1,   // closed form propagation of the constant jerk
+    JLC_SOLVER_ODE1  = 2,   // euler, one derivative evaluation
+    JLC_SOLVER_ODE4  = 3,   // classic runge-kutta, four derivative evaluations (not more accurate than ODE3
+                            // on steps that cross a limit)
+    JLC_N_SOLVERS    = 4
+};
+
+// pointers to the structure-of-arrays data of the lanes, all arrays have n elements
+struct jlc_lanes {
+    int n;
+    // limits and gains
+    const double *sm, *vm, *am, *jm, *kp, *kv, *ka;
+    // setpoint
+    const double *pos, *vel, *acc;
+    // outputs
+    double *POS, *VEL, *ACC, *JRK;
+    // integrators
+    double *q, *v, *a;
+    // delays (outputs of the previous step)
+    double *dq, *dv, *da;
+};
+
+// best instruction set supported by this cpu
+jlc_isa jlc_best_isa();
+const char* jlc_isa_name(jlc_isa isa);
+
+// one major step of size h for all the lanes, with the best or a given instruction set
+// (an isa that the cpu does not support falls back to the best supported one)
+void jlc_step_ode3(const jlc_lanes &l, double h);
+void jlc_step_ode3(const jlc_lanes &l, double h, jlc_isa isa);
+
+void jlc_step_exact(const jlc_lanes &l, double h);
+void jlc_step_exact(const jlc_lanes &l, double h, jlc_isa isa);
+
+void jlc_step_ode1(const jlc_lanes &l, double h, jlc_isa isa);
+void jlc_step_ode4(const jlc_lanes &l, double h, jlc_isa isa);
+
+// solver strategy: every solver is a step function with the same signature, looked up by enum or by name
+typedef void (*jlc_step_fn)(const jlc_lanes &l, double h, jlc_isa isa);
+jlc_step_fn jlc_solver_step_fn(jlc_solver solver);
+const char* jlc_solver_name(jlc_solver solver);
+// "ode1", "ode3", "ode4" or "exact", returns false for an unknown name
+bool jlc_solver_from_name(const char *name, jlc_solver &solver);
+
+// one major step with the given solver
+void jlc_step(const jlc_lanes &l, double h, jlc_solver solver);
+void jlc_step(const jlc_lanes &l, double h, jlc_solver solver, jlc_isa isa);
+
+#endif // JLC_SIMD_KERNEL_H
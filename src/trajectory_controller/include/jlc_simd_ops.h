@@ -0,0 +1,102 @@
+/**
+\file   jlc_simd_ops.h
+\brief  building blocks shared by the kernels of jlc_simd_kernel.h (saturation and jerk per instruction set),
+ *      only included by the kernel sources.
+ *
+ *  the sources that include it have to switch off FP contraction, a fused multiply-add rounds once and
+ *  would give different numbers on the different instruction sets.
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef JLC_SIMD_OPS_H
+#define JLC_SIMD_OPS_H
+
+#include "jlc_simd_kernel.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define JLC_X86 1
+#endif
+
+
+// ============================== scalar ==============================
+
+static inline double sat(double u, double lim){
+    if (u > lim)
+        return lim;
+    else if (u < -lim)
+        return -lim;
+    return u;
+}
+
+// jerk of lane i from the setpoint and the delayed outputs, limited by jm
+static inline double jerk_scalar(const jlc_lanes &l, int i){
+    return sat(((l.pos[i] - l.dq[i])*l.kp[i] + (l.vel[i] - l.dv[i])*l.kv[i]) + (l.acc[i] - l.da[i])*l.ka[i], l.jm[i]);
+}
+
+
+#ifdef JLC_X86
+
+// ============================== AVX2 ==============================
+
+#define JLC_AVX2 __attribute__((target("avx2")))
+
+JLC_AVX2 static inline __m256d sat_avx2(__m256d u, __m256d lim){
+    const __m256d nlim = _mm256_xor_pd(lim, _mm256_set1_pd(-0.0));
+    __m256d r = _mm256_blendv_pd(u, nlim, _mm256_cmp_pd(u, nlim, _CMP_LT_OQ));
+    return _mm256_blendv_pd(r, lim, _mm256_cmp_pd(u, lim, _CMP_GT_OQ));  // u > lim has priority
+}
+
+// inside [-lim, lim]
+JLC_AVX2 static inline __m256d inside_avx2(__m256d u, __m256d lim){
+    const __m256d nlim = _mm256_xor_pd(lim, _mm256_set1_pd(-0.0));
+    return _mm256_and_pd(_mm256_cmp_pd(u, lim, _CMP_LE_OQ), _mm256_cmp_pd(u, nlim, _CMP_GE_OQ));
+}
+
+JLC_AVX2 static inline __m256d jerk_avx2(const jlc_lanes &l, int i){
+    const __m256d ep = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(l.pos+i), _mm256_loadu_pd(l.dq+i)), _mm256_loadu_pd(l.kp+i));
+    const __m256d ev = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(l.vel+i), _mm256_loadu_pd(l.dv+i)), _mm256_loadu_pd(l.kv+i));
+    const __m256d ea = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(l.acc+i), _mm256_loadu_pd(l.da+i)), _mm256_loadu_pd(l.ka+i));
+    return sat_avx2(_mm256_add_pd(_mm256_add_pd(ep, ev), ea), _mm256_loadu_pd(l.jm+i));
+}
+
+
+// ============================== AVX-512 ==============================
+
+#define JLC_AVX512 __attribute__((target("avx512f")))
+
+JLC_AVX512 static inline __m512d neg_avx512(__m512d u){
+    return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(u), _mm512_castpd_si512(_mm512_set1_pd(-0.0))));
+}
+
+JLC_AVX512 static inline __m512d sat_avx512(__m512d u, __m512d lim){
+    const __m512d nlim = neg_avx512(lim);
+    __m512d r = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(u, nlim, _CMP_LT_OQ), u, nlim);
+    return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(u, lim, _CMP_GT_OQ), r, lim);  // u > lim has priority
+}
+
+JLC_AVX512 static inline __mmask8 inside_avx512(__m512d u, __m512d lim){
+    return _mm512_cmp_pd_mask(u, lim, _CMP_LE_OQ) & _mm512_cmp_pd_mask(u, neg_avx512(lim), _CMP_GE_OQ);
+}
+
+// mask of the lanes i .. i+7 that are below n
+static inline __mmask8 tail_mask(int i, int n){
+    const int left = n - i;
+    return left >= 8 ? (__mmask8)0xFF : (__mmask8)((1u << left) - 1);
+}
+
+// masked load/store of lanes i .. i+7 with mask m, lanes outside the mask are zero
+#define LD(p) _mm512_maskz_loadu_pd(m, (p)+i)
+#define ST(p, x) _mm512_mask_storeu_pd((p)+i, m, (x))
+
+JLC_AVX512 static inline __m512d jerk_avx512(const jlc_lanes &l, int i, __mmask8 m){
+    const __m512d ep = _mm512_mul_pd(_mm512_sub_pd(LD(l.pos), LD(l.dq)), LD(l.kp));
+    const __m512d ev = _mm512_mul_pd(_mm512_sub_pd(LD(l.vel), LD(l.dv)), LD(l.kv));
+    const __m512d ea = _mm512_mul_pd(_mm512_sub_pd(LD(l.acc), LD(l.da)), LD(l.ka));
+    return sat_avx512(_mm512_add_pd(_mm512_add_pd(ep, ev), ea), LD(l.jm));
+}
+
+#endif // JLC_X86
+
+#endif // JLC_SIMD_OPS_H
@@ -0,0 +1,71 @@
+/**
+\file   jogging_limits.h
+\brief  position limits of velocity jogging, shared by velocity_jogging_node and the offline bag_regression.
+ *
+ *  after every step the stop distance of each joint (0.5 s at its velocity) is compared with the distance
+ *  to its position limit sm; when it reaches the limit the joint is stopped: its velocity input is zero
+ *  from then on, unless the commanded velocity moves it back from that limit. no ros dependency.
+ *  velocity and position are taken in whole units (truncated), like the abs() of int of the first node:
+ *  the recorded bags were made with it and bag_regression replays them exactly.
+ *
+ *  usage:
+ *      JoggingLimits<6> limits(sm);
+ *      loop: limits.apply(cmd_vel, ctrl.input().vel);  ctrl.step();  limits.update(ctrl.output().POS, ctrl.output().VEL);
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef JOGGING_LIMITS_H
+#define JOGGING_LIMITS_H
+
+#include <math.h>
+
+
+template <int N>
+class JoggingLimits
+{
+public:
+    explicit JoggingLimits(double sm): sm_(sm) { reset(); }
+
+    // no joint stopped
+    void reset(){
+        for (int jt=0; jt<N; jt++) {
+            stop_dist_[jt] = sm_;
+            stop_idx_[jt] = 0;
+        }
+    }
+
+    // velocity input of the controller: cmd_vel, or zero for a joint stopped at a limit that cmd_vel
+    // tries to push beyond it
+    void apply(const double *cmd_vel, double *vel) const {
+        for (int jt=0; jt<N; jt++) {
+            if (stop_idx_[jt] == 0)
+                vel[jt] = cmd_vel[jt];
+            else if (stop_idx_[jt] == 1 && cmd_vel[jt] < 0)
+                vel[jt] = cmd_vel[jt];
+            else if (stop_idx_[jt] == -1 && cmd_vel[jt] > 0)
+                vel[jt] = cmd_vel[jt];
+            else
+                vel[jt] = 0;
+        }
+    }
+
+    // check the position limits with the state after the step
+    void update(const double *POS, const double *VEL){
+        for (int jt=0; jt<N; jt++) {
+            stop_dist_[jt] = .5*1*floor(fabs(VEL[jt]));
+            if (stop_dist_[jt] >= sm_ - floor(fabs(POS[jt])))
+                stop_idx_[jt] = POS[jt] > 0 ? 1 : -1;
+        }
+    }
+
+    // stop distance of each joint at the last update
+    const double* stop_dist() const { return stop_dist_; }
+
+private:
+    double sm_;
+    double stop_dist_[N];
+    int stop_idx_[N];   // 1 / -1: stopped at the positive / negative limit
+};
+
+#endif // JOGGING_LIMITS_H
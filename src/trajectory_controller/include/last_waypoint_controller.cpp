@@ -0,0 +1,82 @@
+/**
+\file   last_waypoint_controller.cpp
+\brief  controller approaching the last waypoint, see last_waypoint_controller.h
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#include "last_waypoint_controller.h"
+
+static const double sm=180,  vm=130,  am=250, jm=500, default_frq=125;
+
+
+LastWaypointController::LastWaypointController(const ros::NodeHandle &nh, const ros::NodeHandle &pnh):
+    ControllerNode<N_JOINTS>(nh, pnh, "/state_last_waypts", default_frq),
+    cmd_traj_acks_(nh_), last_wpt_version_(0)
+{
+    controller_.set_limits(sm, vm, am, jm);
+    controller_.set_gains(1200, 400, 20);
+    step_trace_ = trace_.add_event("STEP:", {"inpos=", "outpos=", "out_vel=", "out_acc="});
+    sub_cmd_pos_ = nh_.subscribe("/cmd_pos", 100, &LastWaypointController::cmd_call_back, this);
+    sub_cmd_traj_ = nh_.subscribe("/cmd_traj", 10, &LastWaypointController::cmd_traj_call_back, this);
+}
+
+
+LastWaypointController::~LastWaypointController(){
+    stop();
+}
+
+
+// command positions call_back
+void LastWaypointController::cmd_call_back(const std_msgs::Float64MultiArray::ConstPtr &msg){
+    if((int)msg->data.size() < n_joints){
+        ROS_WARN_STREAM("cmd_pos has " << msg->data.size() << " values, expected " << n_joints << " joints");
+        return;
+    }
+    waypoint wpt;
+    for(int i=0; i<n_joints; i++){
+        ROS_INFO_STREAM("cmd_tu_received: msg.data[" << i << "] =  " << msg->data[i]);
+        wpt.pos[i]= msg->data[i];
+    }
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    last_wpt_block_.write(wpt);
+}
+
+
+// trajectory chunk call_back: checked once, its last point is the last waypoint, acked
+void LastWaypointController::cmd_traj_call_back(const trajectory_msgs::JointTrajectory::ConstPtr &msg){
+    std::string error;
+    const bool accepted = check_chunk(*msg, n_joints, error);
+    if (accepted) {
+        const std::vector<double> &last = msg->points.back().positions;
+        waypoint wpt;
+        for (int jt=0; jt<n_joints; jt++)
+            wpt.pos[jt] = last[jt];
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        last_wpt_block_.write(wpt);
+    }
+    else
+        ROS_WARN_STREAM("cmd_traj chunk rejected: " << error);
+    cmd_traj_acks_.publish(*msg, accepted, 0, 1, error);
+}
+
+
+// one loop: last waypoint, substeps of the controller, publish
+void LastWaypointController::cycle(){
+    last_wpt_block_.read_newer(last_wpt_, last_wpt_version_);
+    if(last_wpt_version_ == 0)// no waypoints have been recevied
+        return;
+
+    // update the model with last waypoint
+    controller_type::inputs &ctrl_U = controller_.input();
+    for (int jt=0; jt< n_joints; jt++)
+        ctrl_U.pos[jt] = last_wpt_.pos[jt];
+
+    //  run the model STEP fumction, substeps times with the same waypoint
+    step_and_publish(ctrl_U.pos);
+
+    const controller_type::outputs &ctrl_Y = controller_.output();
+    // logged by the trace thread
+    const double step_values[4] = {ctrl_U.pos[0], ctrl_Y.POS[0], ctrl_Y.VEL[0], ctrl_Y.ACC[0]};
+    trace_.record(step_trace_, step_values, 4);
+}
@@ -0,0 +1,54 @@
+/**
+\file   last_waypoint_controller.h
+\brief  controller approaching the last waypoint, used by controller_approaching_last_waypoint and its nodelet.
+ *
+ *  subscribes to "/cmd_pos" and keeps track of the last waypoint: if a new waypoint comes before reaching
+ *  the current one, the current one is neglected and the controller approaches the new one.
+ *  a trajectory on "/cmd_traj" (trajectory_chunk.h) is checked once and its last point becomes the last
+ *  waypoint, the chunk is acked on "/cmd_traj_ack".
+ *  the state is published on "/state_last_waypts" (controller_node.h).
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef LAST_WAYPOINT_CONTROLLER_H
+#define LAST_WAYPOINT_CONTROLLER_H
+
+#include <mutex>
+#include "controller_node.h"
+#include "seqlock_block.h"
+#include "trajectory_chunk.h"
+
+#ifndef N_JOINTS
+#define N_JOINTS 6
+#endif
+
+
+class LastWaypointController: public ControllerNode<N_JOINTS>
+{
+public:
+    LastWaypointController(const ros::NodeHandle &nh, const ros::NodeHandle &pnh);
+    ~LastWaypointController();
+
+private:
+    struct waypoint {
+        double pos[N_JOINTS];
+    };
+
+    void cmd_call_back(const std_msgs::Float64MultiArray::ConstPtr &msg);
+    void cmd_traj_call_back(const trajectory_msgs::JointTrajectory::ConstPtr &msg);
+    void cycle();
+
+    // last waypoint received on cmd_pos or cmd_traj, read by the control loop without locks. the two
+    // callbacks may run in different threads of a spinner: writer_mutex_ keeps one writer of the seqlock
+    SeqlockBlock<waypoint> last_wpt_block_;
+    std::mutex writer_mutex_;
+    ros::Subscriber sub_cmd_pos_;
+    ros::Subscriber sub_cmd_traj_;
+    ChunkAcks cmd_traj_acks_;
+    waypoint last_wpt_;
+    uint64_t last_wpt_version_;   // 0: no waypoints have been recevied
+    int step_trace_;              // trace event of every loop: setpoint and state of joint 0
+};
+
+#endif // LAST_WAYPOINT_CONTROLLER_H
@@ -0,0 +1,150 @@
+/**
+\file   latency_histogram.h
+\brief  log-linear (HDR style) histogram of durations in ns, one writer thread and lock-free readers.
+ *
+ *  the bins are 8 per power of two (3 bits of sub-bucket), so a value is known within 12.5 % over the
+ *  whole range 1 ns .. 2^63 ns, with 488 fixed bins and no allocation.
+ *  record() is called by one thread (the control loop), the counters are atomics so another thread reads
+ *  them with read() while it runs. the counts only grow: the statistics of a time window are those of the
+ *  difference of two snapshots (summary(now, before)), nothing is reset by the reader.
+ *  no ros dependency.
+ *
+ *  usage:
+ *      LatencyHistogram h;                        loop:  h.record(t1 - t0);
+ *      reader:  h.read(now);  latency_summary s = LatencyHistogram::summary(now, before);  before = now;
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <atomic>
+
+
+// CLOCK_MONOTONIC in ns, the clock of RtLoop and TraceLog
+inline int64_t monotonic_ns(){
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (int64_t)t.tv_sec*1000000000 + t.tv_nsec;
+}
+
+
+// statistics of a window, durations in ns (min, p50, p99 and max within the bin precision)
+struct latency_summary {
+    uint64_t count;
+    int64_t min;
+    int64_t p50;
+    int64_t p99;
+    int64_t max;
+    double mean;
+};
+
+
+class LatencyHistogram
+{
+public:
+    static const int sub_bits = 3;
+    static const int n_sub = 1 << sub_bits;
+    static const int n_bins = (64 - sub_bits)*n_sub;   // up to the bins of 2^62
+
+    struct snapshot {
+        uint64_t count;
+        int64_t sum;
+        uint64_t bins[n_bins];
+    };
+
+    LatencyHistogram(): count_(0), sum_(0), max_(0) {
+        for (int b=0; b<n_bins; b++)
+            bins_[b].store(0);
+    }
+
+    // ---------- writer ----------
+    void record(int64_t ns){
+        if (ns < 0)
+            ns = 0;
+        bins_[bin(ns)].fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(ns, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_release);
+        if (ns > max_.load(std::memory_order_relaxed))
+            max_.store(ns, std::memory_order_relaxed);   // only this thread writes it
+    }
+
+    // ---------- any thread ----------
+    void read(snapshot &s) const {
+        s.count = count_.load(std::memory_order_acquire);
+        s.sum = sum_.load(std::memory_order_relaxed);
+        for (int b=0; b<n_bins; b++)
+            s.bins[b] = bins_[b].load(std::memory_order_relaxed);
+    }
+
+    // largest value since the start, exact
+    int64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+    // bin of a value: values below n_sub have their own bin, then n_sub bins per power of two
+    static int bin(int64_t ns){
+        const uint64_t v = (uint64_t)ns;
+        if (v < (uint64_t)n_sub)
+            return (int)v;
+        const int e = 63 - __builtin_clzll(v);                 // v in [2^e, 2^(e+1)), e >= sub_bits
+        const int sub = (int)(v >> (e - sub_bits)) & (n_sub - 1);
+        return (e - sub_bits + 1)*n_sub + sub;
+    }
+
+    // smallest and largest value of a bin
+    static int64_t bin_lower(int b){
+        if (b < n_sub)
+            return b;
+        const int e = b/n_sub + sub_bits - 1;
+        return (int64_t)(((uint64_t)(n_sub + b % n_sub)) << (e - sub_bits));
+    }
+    static int64_t bin_upper(int b){
+        return b + 1 < n_bins ? bin_lower(b + 1) - 1 : INT64_MAX;
+    }
+
+    // statistics of the values recorded between the two snapshots, min from the lower end of its bin,
+    // quantiles and max from the upper end of theirs
+    static latency_summary summary(const snapshot &now, const snapshot &before){
+        latency_summary s;
+        memset(&s, 0, sizeof(s));
+        // counted from the bins, a snapshot taken while recording may have the bin but not yet count
+        for (int b=0; b<n_bins; b++)
+            s.count += now.bins[b] - before.bins[b];
+        if (!s.count)
+            return s;
+        s.mean = (double)(now.sum - before.sum)/s.count;
+        const uint64_t n50 = (s.count + 1)/2, n99 = s.count - s.count/100;
+        uint64_t seen = 0;
+        bool first = true;
+        for (int b=0; b<n_bins; b++) {
+            const uint64_t n = now.bins[b] - before.bins[b];
+            if (!n)
+                continue;
+            if (first) {
+                s.min = bin_lower(b);
+                first = false;
+            }
+            if (seen < n50 && seen + n >= n50)
+                s.p50 = bin_upper(b);
+            if (seen < n99 && seen + n >= n99)
+                s.p99 = bin_upper(b);
+            seen += n;
+            s.max = bin_upper(b);
+        }
+        return s;
+    }
+
+private:
+    LatencyHistogram(const LatencyHistogram&);
+    LatencyHistogram& operator=(const LatencyHistogram&);
+
+    std::atomic<uint64_t> count_;
+    std::atomic<int64_t> sum_;
+    std::atomic<int64_t> max_;
+    std::atomic<uint64_t> bins_[n_bins];
+};
+
+#endif // LATENCY_HISTOGRAM_H
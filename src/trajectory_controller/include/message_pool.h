@@ -0,0 +1,64 @@
+/**
+\file   message_pool.h
+\brief  preallocated ros messages reused for publishing, no heap allocation per cycle.
+ *
+ *  the pool holds n copies of a prototype message (e.g. a Float64MultiArray with its data already sized),
+ *  acquire() gives one that nobody else holds (use_count 1) so it can be written in place and published
+ *  as a boost::shared_ptr: subscribers in the same process (nodelets) get the pointer without
+ *  serialization or copy, and the message goes back to the pool when the last of them drops it.
+ *  when all the messages are still held (slow subscribers) a new one is allocated for this cycle and
+ *  counted in n_allocated(), so a state is never dropped.
+ *  acquire() is called from one thread (the control loop).
+ *
+ *  usage:
+ *      MessagePool<std_msgs::Float64MultiArray> pool(16, proto);
+ *      std_msgs::Float64MultiArrayPtr msg = pool.acquire();  msg->data[i] = ...;  pub.publish(msg);
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef MESSAGE_POOL_H
+#define MESSAGE_POOL_H
+
+#include <vector>
+#include <stdint.h>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+
+template <class M>
+class MessagePool
+{
+public:
+    MessagePool(size_t n, const M &prototype): proto_(prototype), next_(0), allocated_(0) {
+        msgs_.reserve(n);
+        for (size_t k=0; k<n; k++)
+            msgs_.push_back(boost::make_shared<M>(prototype));
+    }
+
+    // a message held by nobody else, with the content of the last time it was used (same sizes as the prototype)
+    boost::shared_ptr<M> acquire(){
+        const size_t n = msgs_.size();
+        for (size_t k=0; k<n; k++) {
+            const size_t i = (next_ + k) % n;
+            if (msgs_[i].unique()) {
+                next_ = i + 1;
+                return msgs_[i];
+            }
+        }
+        allocated_++;
+        return boost::make_shared<M>(proto_);
+    }
+
+    size_t size() const { return msgs_.size(); }
+    // messages allocated because the whole pool was in use
+    uint64_t n_allocated() const { return allocated_; }
+
+private:
+    M proto_;
+    std::vector< boost::shared_ptr<M> > msgs_;
+    size_t next_;
+    uint64_t allocated_;
+};
+
+#endif // MESSAGE_POOL_H
@@ -0,0 +1,72 @@
+/**
+\file   parameter_updates.h
+\brief  limits and gains of a running controller node changed through the topic ~parameters.
+ *
+ *  the message is a Float64MultiArray: 7 values sm vm am jm kp kv ka for all the joints, or 7*n_jts values
+ *  (sm of every joint, then vm .. ka), see JerkLimitedController::parameters_from_array.
+ *  the topic has its own callback queue served by one spinner thread, the callback checks the message and
+ *  writes it to a SeqlockBlock (seqlock_block.h); the control loop calls apply() at the cycle boundary,
+ *  which copies the new parameters into the controller without locks or allocation.
+ *  e.g.  rostopic pub -1 /controller_approaching_each_waypoint/parameters std_msgs/Float64MultiArray \
+ *            "data: [180, 60, 120, 500, 1200, 400, 20]"
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef PARAMETER_UPDATES_H
+#define PARAMETER_UPDATES_H
+
+#include <string>
+#include "ros/ros.h"
+#include "ros/callback_queue.h"
+#include "std_msgs/Float64MultiArray.h"
+#include "seqlock_block.h"
+
+
+template <class Controller>
+class ParameterUpdates
+{
+public:
+    typedef typename Controller::parameters parameters;
+
+    // call after ros::init, subscribes to topic in the private namespace pnh (~ of the node or the nodelet)
+    // and starts the spinner thread
+    explicit ParameterUpdates(const ros::NodeHandle &pnh = ros::NodeHandle("~"), const std::string &topic = "parameters"):
+        nh_(pnh), spinner_(1, &queue_), version_(0) {
+        nh_.setCallbackQueue(&queue_);
+        sub_ = nh_.subscribe(topic, 10, &ParameterUpdates::call_back, this);
+        spinner_.start();
+    }
+
+    ~ParameterUpdates(){ spinner_.stop(); }
+
+    // control loop: gives the last published parameters to the controller, true if there were new ones
+    bool apply(Controller &controller){
+        if (!block_.read_newer(prm_, version_))
+            return false;
+        controller.set_parameters(prm_);
+        return true;
+    }
+
+private:
+    void call_back(const std_msgs::Float64MultiArray::ConstPtr &msg){
+        parameters prm;
+        if (msg->data.empty() || !Controller::parameters_from_array(&msg->data[0], msg->data.size(), prm)) {
+            ROS_WARN_STREAM("parameters: expected 7 or " << 7*Controller::n_joints << " values (sm vm am jm kp kv ka),"
+                            " positive limits and non negative gains, got " << msg->data.size() << " values, ignored");
+            return;
+        }
+        block_.write(prm);
+        ROS_INFO_STREAM("parameters: new limits and gains published");
+    }
+
+    ros::CallbackQueue queue_;
+    ros::NodeHandle nh_;
+    ros::AsyncSpinner spinner_;
+    ros::Subscriber sub_;
+    SeqlockBlock<parameters> block_;
+    parameters prm_;       // copy used by the control loop
+    uint64_t version_;
+};
+
+#endif // PARAMETER_UPDATES_H
@@ -0,0 +1,43 @@
+/**
+\file   pipeline_nodelet.h
+\brief  nodelet loading one of the node classes (controllers, command publishers) into a nodelet manager.
+ *
+ *  the node is constructed in onInit with the handles of the nodelet and started, its loop or sender runs
+ *  in its own thread while the callbacks are served by the manager; it is stopped when the nodelet is
+ *  unloaded. the node class needs a constructor (nh, pnh), start() and stop().
+ *  in one manager the messages go from one nodelet to the other as pointers (no serialization, no socket).
+ *
+ *  usage (in the nodelet library of the package):
+ *      typedef PipelineNodelet<EachWaypointController> EachWaypointNodelet;
+ *      PLUGINLIB_EXPORT_CLASS(trajectory_controller::EachWaypointNodelet, nodelet::Nodelet)
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef PIPELINE_NODELET_H
+#define PIPELINE_NODELET_H
+
+#include <boost/shared_ptr.hpp>
+#include "nodelet/nodelet.h"
+
+
+template <class Node>
+class PipelineNodelet: public nodelet::Nodelet
+{
+public:
+    ~PipelineNodelet(){
+        if (node_)
+            node_->stop();
+    }
+
+private:
+    virtual void onInit(){
+        node_.reset(new Node(getNodeHandle(), getPrivateNodeHandle()));
+        if (!node_->start())
+            NODELET_ERROR_STREAM("could not start " << getName());
+    }
+
+    boost::shared_ptr<Node> node_;
+};
+
+#endif // PIPELINE_NODELET_H
@@ -0,0 +1,233 @@
+/**
+\file   rt_loop.cpp
+\brief  periodic real-time control thread, see rt_loop.h
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#include "rt_loop.h"
+#include <time.h>
+#include <errno.h>
+#include <string.h>
+#include <stdio.h>
+#include <alloca.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+
+static const int64_t NSEC = 1000000000;
+
+static int64_t to_ns(const timespec &t){
+    return (int64_t)t.tv_sec*NSEC + t.tv_nsec;
+}
+
+static timespec from_ns(int64_t ns){
+    timespec t;
+    t.tv_sec = ns / NSEC;
+    t.tv_nsec = ns % NSEC;
+    return t;
+}
+
+static int64_t now_ns(){
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return to_ns(t);
+}
+
+// "what: ok" or "what: failed (reason)"
+static std::string result(const std::string &what, int err){
+    return what + (err == 0 ? ": ok" : std::string(": failed (") + strerror(err) + ")");
+}
+
+
+double rt_stats::latency_quantile(double p) const {
+    const uint64_t target = (uint64_t)(p*cycles);
+    uint64_t count = 0;
+    for (int b=0; b<n_bins; b++) {
+        count += hist[b];
+        if (count > target || count == cycles)
+            return b == n_bins - 1 ? max_latency : (double)(1u << b)*1e-6;
+    }
+    return max_latency;
+}
+
+
+RtLoop::RtLoop(): deadline_(0), running_(false), cycles_(0), overruns_(0), missed_(0), sum_latency_ns_(0), max_latency_ns_(0){
+    for (int b=0; b<rt_stats::n_bins; b++)
+        hist_[b].store(0);
+}
+
+RtLoop::~RtLoop(){
+    stop();
+}
+
+
+// creates the thread with its scheduling and cpu set in the attributes, so it runs with them from its first
+// instruction, priority 0: inherited scheduling, cpu -1: any cpu
+static int create_thread(pthread_t *thread, size_t stack_size, int priority, int cpu, void *(*fn)(void*), void *arg){
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, stack_size);
+    if (priority > 0) {
+        sched_param sp;
+        sp.sched_priority = priority;
+        pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        pthread_attr_setschedparam(&attr, &sp);
+    }
+    if (cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_attr_setaffinity_np(&attr, sizeof(set), &set);
+    }
+    const int err = pthread_create(thread, &attr, fn, arg);
+    pthread_attr_destroy(&attr);
+    return err;
+}
+
+
+bool RtLoop::start(const rt_config &cfg, const std::function<void()> &cycle){
+    if (running_.load() || !(cfg.period > 0))
+        return false;
+    cfg_ = cfg;
+    cycle_ = cycle;
+    std::string report;   // the thread does not touch report_, it is written here only
+
+    // page faults of the process, including the heap allocated later
+    if (cfg_.lock_memory)
+        report += result("mlockall", mlockall(MCL_CURRENT | MCL_FUTURE) == 0 ? 0 : errno) + ", ";
+
+    // priority and cpu of the thread, without privileges (EPERM) it is created again with the normal
+    // scheduling, a cpu that does not exist (EINVAL) leaves it on any cpu
+    const size_t stack_size = cfg_.stack_size + 64*1024;
+    int priority = cfg_.priority, cpu = cfg_.cpu;
+    running_.store(true);
+    int err = create_thread(&thread_, stack_size, priority, cpu, &RtLoop::thread_main, this);
+    int sched_err = 0, cpu_err = 0;
+    while (err != 0) {
+        if (err == EPERM && priority > 0) {
+            sched_err = err;
+            priority = 0;
+        }
+        else if ((err == EINVAL || err == EPERM) && cpu >= 0) {
+            cpu_err = err;
+            cpu = -1;
+        }
+        else
+            break;
+        err = create_thread(&thread_, stack_size, priority, cpu, &RtLoop::thread_main, this);
+    }
+    if (err != 0) {
+        running_.store(false);
+        report_ = report + result("pthread_create", err);
+        return false;
+    }
+
+    char what[32];
+    if (cfg_.priority > 0) {
+        snprintf(what, sizeof(what), "SCHED_FIFO %d", cfg_.priority);
+        report += result(what, sched_err) + ", ";
+    }
+    if (cfg_.cpu >= 0) {
+        snprintf(what, sizeof(what), "pinned to cpu %d", cfg_.cpu);
+        report += result(what, cpu_err) + ", ";
+    }
+    report_ = report + "thread started";
+    return true;
+}
+
+
+void RtLoop::stop(){
+    if (!running_.exchange(false))
+        return;
+    pthread_join(thread_, NULL);
+}
+
+
+void* RtLoop::thread_main(void *self){
+    static_cast<RtLoop*>(self)->run();
+    return NULL;
+}
+
+
+// touches size bytes of stack below the caller, the pages are mapped (and locked) for the cycles afterwards
+__attribute__((noinline)) static void prefault_stack(size_t size){
+    volatile char *stack = (volatile char*)alloca(size);
+    for (size_t i=0; i<size; i+=4096)
+        stack[i] = 0;
+}
+
+void RtLoop::run(){
+    if (cfg_.stack_size > 0)
+        prefault_stack(cfg_.stack_size);
+
+    const int64_t period = (int64_t)(cfg_.period*NSEC + 0.5);
+    int64_t deadline = now_ns();
+    while (running_.load(std::memory_order_relaxed)) {
+        deadline += period;
+        const timespec ts = from_ns(deadline);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {}
+        record(now_ns() - deadline);
+
+        deadline_ = deadline;
+        cycle_();
+
+        // overrun: the cycle ended after the next deadline, start again from the next one in the future
+        const int64_t end = now_ns();
+        if (end > deadline + period) {
+            overruns_.fetch_add(1, std::memory_order_relaxed);
+            const int64_t skip = (end - deadline) / period;
+            deadline += skip*period;
+            missed_.fetch_add(skip, std::memory_order_relaxed);
+        }
+    }
+}
+
+
+void RtLoop::record(int64_t latency_ns){
+    if (latency_ns < 0)
+        latency_ns = 0;
+    cycles_.fetch_add(1, std::memory_order_relaxed);
+    sum_latency_ns_.fetch_add(latency_ns, std::memory_order_relaxed);
+    if (latency_ns > max_latency_ns_.load(std::memory_order_relaxed))
+        max_latency_ns_.store(latency_ns, std::memory_order_relaxed);   // only this thread writes it
+    int b = 0;
+    for (int64_t us = latency_ns / 1000; us > 0 && b < rt_stats::n_bins - 1; us >>= 1)
+        b++;
+    hist_[b].fetch_add(1, std::memory_order_relaxed);
+}
+
+
+rt_stats RtLoop::stats() const {
+    rt_stats s;
+    s.cycles = cycles_.load(std::memory_order_relaxed);
+    s.overruns = overruns_.load(std::memory_order_relaxed);
+    s.missed = missed_.load(std::memory_order_relaxed);
+    s.mean_latency = s.cycles ? 1e-9*sum_latency_ns_.load(std::memory_order_relaxed)/s.cycles : 0;
+    s.max_latency = 1e-9*max_latency_ns_.load(std::memory_order_relaxed);
+    for (int b=0; b<rt_stats::n_bins; b++)
+        s.hist[b] = hist_[b].load(std::memory_order_relaxed);
+    return s;
+}
+
+
+std::string RtLoop::summary() const {
+    const rt_stats s = stats();
+    char line[256];
+    snprintf(line, sizeof(line), "cycles: %llu, overruns: %llu (%llu deadlines missed), wake-up latency: "
+             "mean %.1f us, p99 < %.0f us, max %.1f us\n",
+             (unsigned long long)s.cycles, (unsigned long long)s.overruns, (unsigned long long)s.missed,
+             1e6*s.mean_latency, 1e6*s.latency_quantile(0.99), 1e6*s.max_latency);
+    std::string str = line;
+    for (int b=0; b<rt_stats::n_bins; b++) {
+        if (!s.hist[b])
+            continue;
+        if (b == rt_stats::n_bins - 1)
+            snprintf(line, sizeof(line), "  >= %8u us: %llu\n", 1u << (b - 1), (unsigned long long)s.hist[b]);
+        else
+            snprintf(line, sizeof(line), "  < %9u us: %llu\n", 1u << b, (unsigned long long)s.hist[b]);
+        str += line;
+    }
+    return str;
+}
@@ -0,0 +1,105 @@
+/**
+\file   rt_loop.h
+\brief  periodic real-time control thread: SCHED_FIFO, cpu pinning, locked memory, absolute deadlines.
+ *
+ *  the thread sleeps with clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME) until the next deadline, so the
+ *  period does not drift with the time spent in the cycle, then runs the cycle function.
+ *  for every cycle the wake-up latency (time after the deadline) goes to a histogram with power of two
+ *  bins in microseconds, a cycle that ends after the next deadline is an overrun and the missed deadlines
+ *  are skipped (no burst of late cycles).
+ *  setting the priority, the cpu or locking the memory needs privileges (CAP_SYS_NICE, CAP_IPC_LOCK or
+ *  rtprio/memlock limits). the priority and the cpu are set when the thread is created, its first cycle
+ *  already runs with them. what could not be done is reported by start() and the thread runs anyway.
+ *  linux only. no ros dependency.
+ *
+ *  usage:
+ *      rt_config cfg = rt_config::defaults(0.008);  cfg.priority = 80;  cfg.cpu = 1;
+ *      RtLoop loop;
+ *      loop.start(cfg, cycle_function);  ...  loop.stop();  printf("%s", loop.summary().c_str());
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef RT_LOOP_H
+#define RT_LOOP_H
+
+#include <stdint.h>
+#include <string>
+#include <atomic>
+#include <functional>
+#include <pthread.h>
+
+
+struct rt_config {
+    double period;       // cycle period [s]
+    int priority;        // SCHED_FIFO priority 1..99, 0: keep the normal scheduling
+    int cpu;             // cpu the thread is pinned to, -1: any
+    bool lock_memory;    // mlockall(MCL_CURRENT | MCL_FUTURE), no page faults after start
+    size_t stack_size;   // stack of the thread [bytes], prefaulted before the first cycle
+
+    static rt_config defaults(double period){
+        rt_config c;
+        c.period = period;
+        c.priority = 80;
+        c.cpu = -1;
+        c.lock_memory = true;
+        c.stack_size = 512*1024;
+        return c;
+    }
+};
+
+// timing of the cycles so far, latencies in seconds
+struct rt_stats {
+    static const int n_bins = 24;   // bin 0: < 1 us, bin b: [2^(b-1), 2^b) us, last bin: everything above
+    uint64_t cycles;
+    uint64_t overruns;              // cycles that ended after the next deadline
+    uint64_t missed;                // deadlines skipped after overruns
+    double mean_latency;
+    double max_latency;
+    uint64_t hist[n_bins];
+
+    // upper bound of the bin that holds fraction p of the cycles (e.g. 0.99), in seconds
+    double latency_quantile(double p) const;
+};
+
+
+class RtLoop
+{
+public:
+    RtLoop();
+    ~RtLoop();
+
+    // starts the thread running cycle() every cfg.period, false if the thread could not be created,
+    // what could not be applied of cfg is in setup_report()
+    bool start(const rt_config &cfg, const std::function<void()> &cycle);
+    // asks the thread to end after its current cycle and waits for it
+    void stop();
+    bool running() const { return running_.load(); }
+
+    // deadline of the running cycle (CLOCK_MONOTONIC [ns]), for the cycle function
+    int64_t deadline_ns() const { return deadline_; }
+
+    // e.g. "SCHED_FIFO 80: ok, pinned to cpu 1: failed (Operation not permitted), mlockall: ok"
+    const std::string& setup_report() const { return report_; }
+    // can be called from any thread while running
+    rt_stats stats() const;
+    std::string summary() const;
+
+private:
+    static void* thread_main(void *self);
+    void run();
+    void record(int64_t latency_ns);
+
+    rt_config cfg_;
+    std::function<void()> cycle_;
+    int64_t deadline_;
+    pthread_t thread_;
+    std::atomic<bool> running_;
+    std::string report_;
+
+    std::atomic<uint64_t> cycles_, overruns_, missed_;
+    std::atomic<int64_t> sum_latency_ns_, max_latency_ns_;
+    std::atomic<uint64_t> hist_[rt_stats::n_bins];
+};
+
+#endif // RT_LOOP_H
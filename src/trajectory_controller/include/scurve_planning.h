@@ -0,0 +1,341 @@
+/**
+\file   scurve_planning.h
+\brief  planning kernels of the s_curve (7 phases, jerk limited, rest to rest) that can run in the control loop:
+ *      header only, noexcept, no allocation, no io, a status instead of exceptions.
+ *
+ *  the solver of the jerk time (cubic_eq_real_root) was defined in dyn_limiter_funcs.h and again in
+ *  s_curve_functions.cpp, both throwing, and compute_init_time / compute_time_for_jrk printed on std::cout.
+ *  they are now thin wrappers of the functions here, which never throw nor print and write into buffers
+ *  given by the caller (pointer + size, scurve_span). the limits are sm: pos, vm: vel, am: acc, jm: jerk,
+ *  a profile reaches am before vm (am^2/jm <= vm, checked by scurve_check_limits).
+ *  the phases of a segment of distance Ds >= 0: jerk jrk for Tj, 0 for Ta, -jrk for Tj, 0 for Tv (max vel),
+ *  then the same mirrored, T = 4 Tj + 2 Ta + Tv, Ds = jrk Tj (Tj+Ta) (2 Tj+Ta+Tv).
+ *
+ *  usage:
+ *      scurve_phases ph;
+ *      if (scurve_time_for_jerk(Ds, lim, ph) != SCURVE_OK) ...                // optimal time
+ *      scurve_stretch(Ds, T_new, lim, ph);                                    // same phases, longer
+ *      scurve_segment segs[16];  size_t n_segs;
+ *      scurve_plan_1dof(scurve_span<const double>(wpts, n), 0, lim, scurve_span<scurve_segment>(segs, 16), n_segs);
+ *      scurve_sample(segs[s], t, p, v, a);
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef SCURVE_PLANNING_H
+#define SCURVE_PLANNING_H
+
+#include <math.h>
+#include <stddef.h>
+
+
+enum scurve_status {
+    SCURVE_OK = 0,
+    SCURVE_BAD_ARGUMENT,       // not finite, or a size of zero
+    SCURVE_NOT_CUBIC,          // leading coefficient 0
+    SCURVE_BAD_LIMITS,         // a limit not positive, or am^2/jm > vm
+    SCURVE_TIME_TOO_SHORT,     // reference time shorter than the optimal time, the plan stays optimal
+    SCURVE_EXCEEDS_LIMITS,     // a profile beyond vm, am or jm
+    SCURVE_BUFFER_TOO_SMALL    // more segments than the buffer, the first ones are written
+};
+
+inline const char* scurve_status_name(scurve_status s) noexcept {
+    switch (s) {
+    case SCURVE_OK:               return "ok";
+    case SCURVE_BAD_ARGUMENT:     return "bad argument";
+    case SCURVE_NOT_CUBIC:        return "not a cubic";
+    case SCURVE_BAD_LIMITS:       return "bad limits";
+    case SCURVE_TIME_TOO_SHORT:   return "time shorter than the optimal time";
+    case SCURVE_EXCEEDS_LIMITS:   return "exceeds the limits";
+    case SCURVE_BUFFER_TOO_SMALL: return "buffer too small";
+    }
+    return "unknown";
+}
+
+
+// a buffer of the caller (std::span is C++20)
+template <class T>
+struct scurve_span {
+    T *data;
+    size_t size;
+    scurve_span(T *d, size_t n): data(d), size(n) {}
+    T& operator[](size_t i) const { return data[i]; }
+};
+
+struct scurve_limits {
+    double sm, vm, am, jm;
+};
+
+struct scurve_phases {
+    double Tj, Ta, Tv, T;
+    double jrk;                // signed
+};
+
+// one rest to rest move, from p0 by Ds
+struct scurve_segment {
+    double p0, Ds;
+    scurve_phases ph;
+};
+
+
+// ============================== closed forms ==============================
+
+constexpr double scurve_duration(double Tj, double Ta, double Tv) noexcept {
+    return 4*Tj + 2*Ta + Tv;
+}
+
+// distance of the profile at unit jerk
+constexpr double scurve_unit_distance(double Tj, double Ta, double Tv) noexcept {
+    return Tj*(Tj + Ta)*(2*Tj + Ta + Tv);
+}
+
+// shortest distance that reaches vm (Ta >= 0, Tv = 0), and am (Ta = 0, Tj = am/jm)
+constexpr double scurve_dist_vm(const scurve_limits &l) noexcept {
+    return (l.am*l.vm)/l.jm + (l.vm*l.vm)/l.am;
+}
+constexpr double scurve_dist_am(const scurve_limits &l) noexcept {
+    return 2*l.am*l.am*l.am/(l.jm*l.jm);
+}
+
+inline scurve_status scurve_check_limits(const scurve_limits &l) noexcept {
+    if (!(l.vm > 0 && l.am > 0 && l.jm > 0) || !isfinite(l.vm) || !isfinite(l.am) || !isfinite(l.jm))
+        return SCURVE_BAD_LIMITS;
+    if (l.am*l.am > l.vm*l.jm)
+        return SCURVE_BAD_LIMITS;
+    return SCURVE_OK;
+}
+
+
+// ============================== cubic ==============================
+
+// real roots of a x^3 + b x^2 + c x + d = 0 (Cardano / trigonometric), n_roots: 1 (roots[1], roots[2] NaN),
+// 2 (roots[1] == roots[2], a double root) or 3, same cases as cubic_eq_real_root
+inline scurve_status scurve_cubic_real_roots(double a, double b, double c, double d, double roots[3],
+                                             int &n_roots) noexcept {
+    n_roots = 0;
+    roots[0] = roots[1] = roots[2] = NAN;
+    if (a == 0)
+        return SCURVE_NOT_CUBIC;
+    if (!isfinite(a) || !isfinite(b) || !isfinite(c) || !isfinite(d))
+        return SCURVE_BAD_ARGUMENT;
+    b /= a;
+    c /= a;
+    d /= a;
+    double q = (3.0*c - b*b)/9.0;
+    const double r = (-(27.0*d) + b*(9.0*c - 2.0*(b*b)))/54.0;
+    const double disc = q*q*q + r*r;
+    const double tol = 1e-10*(r*r + fabs(q*q*q));   // relative: the coefficients of the jerk cubic are tiny
+    const double term1 = b/3.0;
+    if (disc > tol) {              // one real root, two complex
+        const double s = cbrt(r + sqrt(disc));
+        const double t = cbrt(r - sqrt(disc));
+        roots[0] = -term1 + s + t;
+        n_roots = 1;
+    }
+    else if (disc >= -tol) {       // all real, at least two equal
+        const double r13 = cbrt(r);
+        roots[0] = -term1 + 2.0*r13;
+        roots[1] = roots[2] = -(r13 + term1);
+        n_roots = 2;
+    }
+    else {                         // three different real roots (q < 0)
+        q = -q;
+        const double cos3 = r/sqrt(q*q*q);   // within [-1, 1] but for rounding
+        const double dum1 = acos(cos3 > 1 ? 1 : (cos3 < -1 ? -1 : cos3));
+        const double r13 = 2.0*sqrt(q);
+        roots[0] = -term1 + r13*cos(dum1/3.0);
+        roots[1] = -term1 + r13*cos((dum1 + 2.0*M_PI)/3.0);
+        roots[2] = -term1 + r13*cos((dum1 + 4.0*M_PI)/3.0);
+        n_roots = 3;
+    }
+    return SCURVE_OK;
+}
+
+// smallest non negative of n roots, 0 if none (min_root of s_curve_functions.cpp)
+inline double scurve_min_root(const double *roots, int n) noexcept {
+    double rt = 0;
+    bool found = false;
+    for (int i=0; i<n; i++)
+        if (roots[i] >= 0 && (!found || roots[i] < rt)) {
+            rt = roots[i];
+            found = true;
+        }
+    return rt;
+}
+
+
+// ============================== one segment ==============================
+
+// phases of the optimal (minimum time) profile of the distance |Ds| at jerk jm, jrk signed like Ds
+inline scurve_status scurve_time_for_jerk(double Ds, const scurve_limits &l, scurve_phases &ph) noexcept {
+    ph.Tj = ph.Ta = ph.Tv = ph.T = ph.jrk = 0;
+    const scurve_status st = scurve_check_limits(l);
+    if (st != SCURVE_OK)
+        return st;
+    if (!isfinite(Ds))
+        return SCURVE_BAD_ARGUMENT;
+    const double D = fabs(Ds);
+    if (D == 0)
+        return SCURVE_OK;
+    if (D >= scurve_dist_vm(l)) {          // reaches am and vm
+        ph.Tj = l.am/l.jm;
+        ph.Ta = l.vm/l.am - l.am/l.jm;
+        ph.Tv = (D - scurve_dist_vm(l))/l.vm;
+    }
+    else if (D >= scurve_dist_am(l)) {     // reaches am only
+        ph.Tj = l.am/l.jm;
+        ph.Ta = sqrt(ph.Tj*ph.Tj/4 + D/l.am) - 1.5*ph.Tj;
+    }
+    else {                                 // reaches neither: 2 jm Tj^3 = D
+        ph.Tj = cbrt(D/(2*l.jm));
+    }
+    ph.T = scurve_duration(ph.Tj, ph.Ta, ph.Tv);
+    ph.jrk = Ds > 0 ? l.jm : -l.jm;
+    return SCURVE_OK;
+}
+
+// stretches the phases of Ds (from scurve_time_for_jerk) in proportion to the time T_new >= ph.T, the jerk
+// follows (compute_jerk_for_time), ph unchanged if it is not possible
+inline scurve_status scurve_stretch(double Ds, double T_new, const scurve_limits &l, scurve_phases &ph) noexcept {
+    if (!isfinite(T_new) || !isfinite(Ds))
+        return SCURVE_BAD_ARGUMENT;
+    if (ph.T <= 0)
+        return Ds == 0 ? SCURVE_OK : SCURVE_BAD_ARGUMENT;
+    if (T_new < ph.T*(1 - 1e-12))
+        return SCURVE_TIME_TOO_SHORT;
+    const double k = T_new/ph.T;
+    const double Tj = k*ph.Tj, Ta = k*ph.Ta, Tv = k*ph.Tv;
+    const double jrk = fabs(Ds)/scurve_unit_distance(Tj, Ta, Tv);
+    const double tol = 1 + 1e-9;
+    if (jrk > tol*l.jm || jrk*Tj > tol*l.am || jrk*Tj*(Tj + Ta) > tol*l.vm)
+        return SCURVE_EXCEEDS_LIMITS;
+    ph.Tj = Tj;
+    ph.Ta = Ta;
+    ph.Tv = Tv;
+    ph.T = scurve_duration(Tj, Ta, Tv);
+    ph.jrk = Ds > 0 ? jrk : -jrk;
+    return SCURVE_OK;
+}
+
+// pos, vel, acc of a segment t after its start (clamped to [0, T]), the phases in closed form
+inline void scurve_sample(const scurve_segment &s, double t, double &p, double &v, double &a) noexcept {
+    const scurve_phases &ph = s.ph;
+    const double J = ph.jrk, Tj = ph.Tj, Ta = ph.Ta, Tv = ph.Tv;
+    if (J == 0 || !(t > 0)) {     // rests, or not started
+        p = s.p0;
+        v = a = 0;
+        return;
+    }
+    if (t > ph.T)
+        t = ph.T;
+    // the second half mirrors the first one: from the end backwards, acc and position distance change sign
+    const double t_half = 2*Tj + Ta + 0.5*Tv;
+    const bool second = t > t_half;
+    const double u = second ? ph.T - t : t;
+    // first half from rest: j1, a1, j2, then v
+    const double A = J*Tj;                        // acc of a1
+    const double V1 = 0.5*J*Tj*Tj;                // vel at the end of j1
+    const double P1 = J*Tj*Tj*Tj/6;
+    double pp, vv, aa;
+    if (u < Tj) {
+        aa = J*u;
+        vv = 0.5*J*u*u;
+        pp = J*u*u*u/6;
+    }
+    else if (u < Tj + Ta) {
+        const double w = u - Tj;
+        aa = A;
+        vv = V1 + A*w;
+        pp = P1 + V1*w + 0.5*A*w*w;
+    }
+    else {
+        const double w = u - Tj - Ta;
+        const double V2 = V1 + A*Ta, P2 = P1 + V1*Ta + 0.5*A*Ta*Ta;
+        const double wj = w < Tj ? w : Tj;        // j2, then constant velocity
+        aa = A - J*wj;
+        vv = V2 + A*wj - 0.5*J*wj*wj;
+        pp = P2 + V2*wj + 0.5*A*wj*wj - J*wj*wj*wj/6 + vv*(w - wj);
+    }
+    if (second) {
+        p = s.p0 + s.Ds - pp;
+        v = vv;
+        a = -aa;
+    }
+    else {
+        p = s.p0 + pp;
+        v = vv;
+        a = aa;
+    }
+}
+
+// position where a joint at (p0, v0 >= 0, a0) stops, braking with -jm then +jm until vel and acc are 0
+// (compute_stop_distance)
+inline double scurve_stop_distance(double a0, double v0, double p0, double jm) noexcept {
+    if (fabs(v0) <= 0.001 && fabs(a0) <= 0.001)
+        return 0;
+    const double t2 = sqrt(a0*a0/(2*jm*jm) + v0/jm);
+    const double t1 = t2 + a0/jm;
+    const double a1 = -jm*t1 + a0;
+    const double v1 = -jm*t1*t1/2 + a0*t1 + v0;
+    const double p1 = -jm*t1*t1*t1/6 + a0*t1*t1/2 + v0*t1 + p0;
+    return jm*t2*t2*t2/6 + a1*t2*t2/2 + v1*t2 + p1;
+}
+
+
+// ============================== path ==============================
+
+// optimal rest to rest segments of one joint through the n waypoints, cut where the direction reverses
+// (waypoints in between on the way are not stopped at). ref_T > optimal time: every segment stretched by
+// the same ratio, ref_T shorter: SCURVE_TIME_TOO_SHORT with the optimal plan. n_segs: segments written
+inline scurve_status scurve_plan_1dof(scurve_span<const double> wpts, double ref_T, const scurve_limits &l,
+                                      scurve_span<scurve_segment> segs, size_t &n_segs) noexcept {
+    n_segs = 0;
+    if (wpts.size < 1 || segs.size < 1)
+        return SCURVE_BAD_ARGUMENT;
+    for (size_t i=0; i<wpts.size; i++)
+        if (!isfinite(wpts[i]))
+            return SCURVE_BAD_ARGUMENT;
+    const scurve_status lim = scurve_check_limits(l);
+    if (lim != SCURVE_OK)
+        return lim;
+
+    scurve_status st = SCURVE_OK;
+    double T_opt = 0, dir = 0;
+    size_t start = 0;
+    for (size_t i=1; i<=wpts.size; i++) {
+        // ends a segment at i-1 if the path reverses there, or at the last waypoint
+        const bool last = i == wpts.size;
+        const double d = last ? 0 : wpts[i] - wpts[i-1];
+        const bool reverse = !last && fabs(d) > 1e-5 && d*dir < 0;
+        if (!last && !reverse) {
+            if (fabs(d) > 1e-5)
+                dir = d;
+            continue;
+        }
+        const double Ds = wpts[i-1] - wpts[start];
+        if (i-1 > start || n_segs == 0) {
+            if (n_segs == segs.size) {
+                st = SCURVE_BUFFER_TOO_SMALL;
+                break;
+            }
+            scurve_segment &s = segs[n_segs++];
+            s.p0 = wpts[start];
+            s.Ds = fabs(Ds) <= 1e-5 ? 0 : Ds;
+            scurve_time_for_jerk(s.Ds, l, s.ph);
+            T_opt += s.ph.T;
+        }
+        start = i-1;
+        dir = d;
+    }
+    if (st != SCURVE_OK || ref_T <= 0)
+        return st;
+    if (ref_T < T_opt)
+        return SCURVE_TIME_TOO_SHORT;
+    const double k = T_opt > 0 ? ref_T/T_opt : 1;
+    for (size_t s=0; s<n_segs; s++)
+        if (segs[s].ph.T > 0)
+            scurve_stretch(segs[s].Ds, k*segs[s].ph.T, l, segs[s].ph);   // slower: within the limits
+    return SCURVE_OK;
+}
+
+#endif // SCURVE_PLANNING_H
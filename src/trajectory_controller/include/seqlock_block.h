@@ -0,0 +1,73 @@
+/**
+\file   seqlock_block.h
+\brief  block of plain data written by one thread and read by another without locks (sequence lock).
+ *
+ *  the writer (e.g. a parameter topic callback on its own spinner thread) bumps the sequence number to odd,
+ *  stores the words and bumps it to even again; the reader (the control loop) copies the words and keeps
+ *  the copy only if the sequence number was even and did not change meanwhile.
+ *  the reader never waits and never allocates: when a write is in progress it gets nothing and tries again
+ *  at the next cycle. only one writer thread at a time.
+ *  T has to be trivially copyable with a size multiple of 8 bytes (e.g. a struct of doubles).
+ *
+ *  usage:
+ *      SeqlockBlock<prm_t> block;             writer:  block.write(prm);
+ *      uint64_t version = 0;                  reader:  if (block.read_newer(prm, version)) apply(prm);
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef SEQLOCK_BLOCK_H
+#define SEQLOCK_BLOCK_H
+
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
+
+
+template <class T>
+class SeqlockBlock
+{
+    static_assert(sizeof(T) % sizeof(uint64_t) == 0, "SeqlockBlock: size of T has to be a multiple of 8 bytes");
+    static const int n_words = sizeof(T) / sizeof(uint64_t);
+
+public:
+    SeqlockBlock(): seq_(0) {
+        for (int i=0; i<n_words; i++)
+            words_[i].store(0, std::memory_order_relaxed);
+    }
+
+    // publish a new value (single writer)
+    void write(const T &value){
+        uint64_t w[n_words];
+        memcpy(w, &value, sizeof(T));
+        const uint64_t s = seq_.load(std::memory_order_relaxed);
+        seq_.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (int i=0; i<n_words; i++)
+            words_[i].store(w[i], std::memory_order_relaxed);
+        seq_.store(s + 2, std::memory_order_release);
+    }
+
+    // copies the block to value if it was written after version (0 at the start) and updates version,
+    // false if there is nothing new or a write is in progress, value is untouched then
+    bool read_newer(T &value, uint64_t &version) const {
+        const uint64_t s0 = seq_.load(std::memory_order_acquire);
+        if (s0 == version || (s0 & 1))
+            return false;
+        uint64_t w[n_words];
+        for (int i=0; i<n_words; i++)
+            w[i] = words_[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) != s0)
+            return false;
+        memcpy(&value, w, sizeof(T));
+        version = s0;
+        return true;
+    }
+
+private:
+    std::atomic<uint64_t> seq_;
+    std::atomic<uint64_t> words_[n_words];
+};
+
+#endif // SEQLOCK_BLOCK_H
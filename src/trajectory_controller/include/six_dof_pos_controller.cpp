@@ -22,31 +22,12 @@
 #include "six_dof_pos_controller.h"
 #include "six_dof_pos_controller_private.h"
 
-/* Block signals (default storage) */
-B_six_dof_pos_controller_T six_dof_pos_controller_B;
-
-/* Continuous states */
-X_six_dof_pos_controller_T six_dof_pos_controller_X;
-
-/* Block states (default storage) */
-DW_six_dof_pos_controller_T six_dof_pos_controller_DW;
-
-/* External inputs (root inport signals with default storage) */
-ExtU_six_dof_pos_controller_T six_dof_pos_controller_U;
-
-/* External outputs (root outports fed by signals with default storage) */
-ExtY_six_dof_pos_controller_T six_dof_pos_controller_Y;
-
-/* Real-time model */
-RT_MODEL_six_dof_pos_controll_T six_dof_pos_controller_M_;
-RT_MODEL_six_dof_pos_controll_T *const six_dof_pos_controller_M =
-  &six_dof_pos_controller_M_;
-
 /*
  * This function updates continuous states using the ODE3 fixed-step
  * solver algorithm
  */
-static void rt_ertODEUpdateContinuousStates(RTWSolverInfo *si )
+void six_dof_pos_controllerModelClass::rt_ertODEUpdateContinuousStates
+  (RTWSolverInfo *si )
 {
   /* Solver Matrices */
   static const real_T rt_ODE3_A[3] = {
@@ -82,7 +63,7 @@ static void rt_ertODEUpdateContinuousStates(RTWSolverInfo *si )
   /* Assumes that rtsiSetT and ModelOutputs are up-to-date */
   /* f0 = f(t,y) */
   rtsiSetdX(si, f0);
-  six_dof_pos_controller_derivatives();
+  this->derivatives();
 
   /* f(:,2) = feval(odefile, t + hA(1), y + f*hB(:,1), args(:)(*)); */
   hB[0] = h * rt_ODE3_B[0][0];
@@ -92,8 +73,8 @@ static void rt_ertODEUpdateContinuousStates(RTWSolverInfo *si )
 
   rtsiSetT(si, t + h*rt_ODE3_A[0]);
   rtsiSetdX(si, f1);
-  six_dof_pos_controller_step();
-  six_dof_pos_controller_derivatives();
+  this->step();
+  this->derivatives();
 
   /* f(:,3) = feval(odefile, t + hA(2), y + f*hB(:,2), args(:)(*)); */
   for (i = 0; i <= 1; i++) {
@@ -106,8 +87,8 @@ static void rt_ertODEUpdateContinuousStates(RTWSolverInfo *si )
 
   rtsiSetT(si, t + h*rt_ODE3_A[1]);
   rtsiSetdX(si, f2);
-  six_dof_pos_controller_step();
-  six_dof_pos_controller_derivatives();
+  this->step();
+  this->derivatives();
 
   /* tnew = t + hA(3);
      ynew = y + f*hB(:,3); */
@@ -124,28 +105,28 @@ static void rt_ertODEUpdateContinuousStates(RTWSolverInfo *si )
 }
 
 /* Model step function */
-void six_dof_pos_controller_step(void)
+void six_dof_pos_controllerModelClass::step()
 {
   real_T u0;
-  if (rtmIsMajorTimeStep(six_dof_pos_controller_M)) {
+  if (rtmIsMajorTimeStep((&six_dof_pos_controller_M))) {
     /* set solver stop time */
-    if (!(six_dof_pos_controller_M->Timing.clockTick0+1)) {
-      rtsiSetSolverStopTime(&six_dof_pos_controller_M->solverInfo,
-                            ((six_dof_pos_controller_M->Timing.clockTickH0 + 1) *
-        six_dof_pos_controller_M->Timing.stepSize0 * 4294967296.0));
+    if (!((&six_dof_pos_controller_M)->Timing.clockTick0+1)) {
+      rtsiSetSolverStopTime(&(&six_dof_pos_controller_M)->solverInfo,
+                            (((&six_dof_pos_controller_M)->Timing.clockTickH0 + 1) *
+        (&six_dof_pos_controller_M)->Timing.stepSize0 * 4294967296.0));
     } else {
-      rtsiSetSolverStopTime(&six_dof_pos_controller_M->solverInfo,
-                            ((six_dof_pos_controller_M->Timing.clockTick0 + 1) *
-        six_dof_pos_controller_M->Timing.stepSize0 +
-        six_dof_pos_controller_M->Timing.clockTickH0 *
-        six_dof_pos_controller_M->Timing.stepSize0 * 4294967296.0));
+      rtsiSetSolverStopTime(&(&six_dof_pos_controller_M)->solverInfo,
+                            (((&six_dof_pos_controller_M)->Timing.clockTick0 + 1) *
+        (&six_dof_pos_controller_M)->Timing.stepSize0 +
+        (&six_dof_pos_controller_M)->Timing.clockTickH0 *
+        (&six_dof_pos_controller_M)->Timing.stepSize0 * 4294967296.0));
     }
   }                                    /* end MajorTimeStep */
 
   /* Update absolute time of base rate at minor time step */
-  if (rtmIsMinorTimeStep(six_dof_pos_controller_M)) {
-    six_dof_pos_controller_M->Timing.t[0] = rtsiGetT
-      (&six_dof_pos_controller_M->solverInfo);
+  if (rtmIsMinorTimeStep((&six_dof_pos_controller_M))) {
+    (&six_dof_pos_controller_M)->Timing.t[0] = rtsiGetT
+      (&(&six_dof_pos_controller_M)->solverInfo);
   }
 
   /* Saturate: '<S2>/Saturation2' incorporates:
@@ -450,7 +431,7 @@ void six_dof_pos_controller_step(void)
   six_dof_pos_controller_Y.ACC[3] = six_dof_pos_controller_B.acc_m;
   six_dof_pos_controller_Y.ACC[4] = six_dof_pos_controller_B.acc_e;
   six_dof_pos_controller_Y.ACC[5] = six_dof_pos_controller_B.acc_mv;
-  if (rtmIsMajorTimeStep(six_dof_pos_controller_M)) {
+  if (rtmIsMajorTimeStep((&six_dof_pos_controller_M))) {
     /* Sum: '<S2>/Sum3' incorporates:
      *  Delay: '<S2>/Delay1'
      *  Delay: '<S2>/Delay2'
@@ -718,14 +699,10 @@ void six_dof_pos_controller_step(void)
     six_dof_pos_controller_Y.JRK[5] = six_dof_pos_controller_B.Saturation7_g;
   }
 
-  if (rtmIsMajorTimeStep(six_dof_pos_controller_M)) {
-    /* Matfile logging */
-    rt_UpdateTXYLogVars(six_dof_pos_controller_M->rtwLogInfo,
-                        (six_dof_pos_controller_M->Timing.t));
-  }                                    /* end MajorTimeStep */
+  /* Matfile logging: not done by the class, see initialize() */
 
-  if (rtmIsMajorTimeStep(six_dof_pos_controller_M)) {
-    if (rtmIsMajorTimeStep(six_dof_pos_controller_M)) {
+  if (rtmIsMajorTimeStep((&six_dof_pos_controller_M))) {
+    if (rtmIsMajorTimeStep((&six_dof_pos_controller_M))) {
       /* Update for Delay: '<S2>/Delay3' */
       six_dof_pos_controller_DW.Delay3_DSTATE = six_dof_pos_controller_B.q;
 
@@ -783,21 +760,21 @@ void six_dof_pos_controller_step(void)
     }
   }                                    /* end MajorTimeStep */
 
-  if (rtmIsMajorTimeStep(six_dof_pos_controller_M)) {
+  if (rtmIsMajorTimeStep((&six_dof_pos_controller_M))) {
     /* signal main to stop simulation */
     {                                  /* Sample time: [0.0s, 0.0s] */
-      if ((rtmGetTFinal(six_dof_pos_controller_M)!=-1) &&
-          !((rtmGetTFinal(six_dof_pos_controller_M)-
-             (((six_dof_pos_controller_M->Timing.clockTick1+
-                six_dof_pos_controller_M->Timing.clockTickH1* 4294967296.0)) *
-              0.008)) > (((six_dof_pos_controller_M->Timing.clockTick1+
-                           six_dof_pos_controller_M->Timing.clockTickH1*
+      if ((rtmGetTFinal((&six_dof_pos_controller_M))!=-1) &&
+          !((rtmGetTFinal((&six_dof_pos_controller_M))-
+             ((((&six_dof_pos_controller_M)->Timing.clockTick1+
+                (&six_dof_pos_controller_M)->Timing.clockTickH1* 4294967296.0)) *
+              0.008)) > ((((&six_dof_pos_controller_M)->Timing.clockTick1+
+                           (&six_dof_pos_controller_M)->Timing.clockTickH1*
                            4294967296.0)) * 0.008) * (DBL_EPSILON))) {
-        rtmSetErrorStatus(six_dof_pos_controller_M, "Simulation finished");
+        rtmSetErrorStatus((&six_dof_pos_controller_M), "Simulation finished");
       }
     }
 
-    rt_ertODEUpdateContinuousStates(&six_dof_pos_controller_M->solverInfo);
+    rt_ertODEUpdateContinuousStates(&(&six_dof_pos_controller_M)->solverInfo);
 
     /* Update absolute time for base rate */
     /* The "clockTick0" counts the number of times the code of this task has
@@ -808,12 +785,12 @@ void six_dof_pos_controller_step(void)
      * The two integers represent the low bits Timing.clockTick0 and the high bits
      * Timing.clockTickH0. When the low bit overflows to 0, the high bits increment.
      */
-    if (!(++six_dof_pos_controller_M->Timing.clockTick0)) {
-      ++six_dof_pos_controller_M->Timing.clockTickH0;
+    if (!(++(&six_dof_pos_controller_M)->Timing.clockTick0)) {
+      ++(&six_dof_pos_controller_M)->Timing.clockTickH0;
     }
 
-    six_dof_pos_controller_M->Timing.t[0] = rtsiGetSolverStopTime
-      (&six_dof_pos_controller_M->solverInfo);
+    (&six_dof_pos_controller_M)->Timing.t[0] = rtsiGetSolverStopTime
+      (&(&six_dof_pos_controller_M)->solverInfo);
 
     {
       /* Update absolute timer for sample time: [0.008s, 0.0s] */
@@ -825,19 +802,19 @@ void six_dof_pos_controller_step(void)
        * The two integers represent the low bits Timing.clockTick1 and the high bits
        * Timing.clockTickH1. When the low bit overflows to 0, the high bits increment.
        */
-      six_dof_pos_controller_M->Timing.clockTick1++;
-      if (!six_dof_pos_controller_M->Timing.clockTick1) {
-        six_dof_pos_controller_M->Timing.clockTickH1++;
+      (&six_dof_pos_controller_M)->Timing.clockTick1++;
+      if (!(&six_dof_pos_controller_M)->Timing.clockTick1) {
+        (&six_dof_pos_controller_M)->Timing.clockTickH1++;
       }
     }
   }                                    /* end MajorTimeStep */
 }
 
 /* Derivatives for root system: '<Root>' */
-void six_dof_pos_controller_derivatives(void)
+void six_dof_pos_controllerModelClass::derivatives()
 {
   XDot_six_dof_pos_controller_T *_rtXdot;
-  _rtXdot = ((XDot_six_dof_pos_controller_T *) six_dof_pos_controller_M->derivs);
+  _rtXdot = ((XDot_six_dof_pos_controller_T *) (&six_dof_pos_controller_M)->derivs);
 
   /* Derivatives for Integrator: '<S2>/Integrator1' */
   _rtXdot->Integrator1_CSTATE = six_dof_pos_controller_B.vel;
@@ -895,7 +872,7 @@ void six_dof_pos_controller_derivatives(void)
 }
 
 /* Model initialize function */
-void six_dof_pos_controller_initialize(void)
+void six_dof_pos_controllerModelClass::initialize()
 {
   /* Registration code */
 
@@ -903,71 +880,70 @@ void six_dof_pos_controller_initialize(void)
   rt_InitInfAndNaN(sizeof(real_T));
 
   /* initialize real-time model */
-  (void) memset((void *)six_dof_pos_controller_M, 0,
+  (void) memset((void *)(&six_dof_pos_controller_M), 0,
                 sizeof(RT_MODEL_six_dof_pos_controll_T));
 
   {
     /* Setup solver object */
-    rtsiSetSimTimeStepPtr(&six_dof_pos_controller_M->solverInfo,
-                          &six_dof_pos_controller_M->Timing.simTimeStep);
-    rtsiSetTPtr(&six_dof_pos_controller_M->solverInfo, &rtmGetTPtr
-                (six_dof_pos_controller_M));
-    rtsiSetStepSizePtr(&six_dof_pos_controller_M->solverInfo,
-                       &six_dof_pos_controller_M->Timing.stepSize0);
-    rtsiSetdXPtr(&six_dof_pos_controller_M->solverInfo,
-                 &six_dof_pos_controller_M->derivs);
-    rtsiSetContStatesPtr(&six_dof_pos_controller_M->solverInfo, (real_T **)
-                         &six_dof_pos_controller_M->contStates);
-    rtsiSetNumContStatesPtr(&six_dof_pos_controller_M->solverInfo,
-      &six_dof_pos_controller_M->Sizes.numContStates);
-    rtsiSetNumPeriodicContStatesPtr(&six_dof_pos_controller_M->solverInfo,
-      &six_dof_pos_controller_M->Sizes.numPeriodicContStates);
-    rtsiSetPeriodicContStateIndicesPtr(&six_dof_pos_controller_M->solverInfo,
-      &six_dof_pos_controller_M->periodicContStateIndices);
-    rtsiSetPeriodicContStateRangesPtr(&six_dof_pos_controller_M->solverInfo,
-      &six_dof_pos_controller_M->periodicContStateRanges);
-    rtsiSetErrorStatusPtr(&six_dof_pos_controller_M->solverInfo,
-                          (&rtmGetErrorStatus(six_dof_pos_controller_M)));
-    rtsiSetRTModelPtr(&six_dof_pos_controller_M->solverInfo,
-                      six_dof_pos_controller_M);
+    rtsiSetSimTimeStepPtr(&(&six_dof_pos_controller_M)->solverInfo,
+                          &(&six_dof_pos_controller_M)->Timing.simTimeStep);
+    rtsiSetTPtr(&(&six_dof_pos_controller_M)->solverInfo, &rtmGetTPtr
+                ((&six_dof_pos_controller_M)));
+    rtsiSetStepSizePtr(&(&six_dof_pos_controller_M)->solverInfo,
+                       &(&six_dof_pos_controller_M)->Timing.stepSize0);
+    rtsiSetdXPtr(&(&six_dof_pos_controller_M)->solverInfo,
+                 &(&six_dof_pos_controller_M)->derivs);
+    rtsiSetContStatesPtr(&(&six_dof_pos_controller_M)->solverInfo, (real_T **)
+                         &(&six_dof_pos_controller_M)->contStates);
+    rtsiSetNumContStatesPtr(&(&six_dof_pos_controller_M)->solverInfo,
+      &(&six_dof_pos_controller_M)->Sizes.numContStates);
+    rtsiSetNumPeriodicContStatesPtr(&(&six_dof_pos_controller_M)->solverInfo,
+      &(&six_dof_pos_controller_M)->Sizes.numPeriodicContStates);
+    rtsiSetPeriodicContStateIndicesPtr(&(&six_dof_pos_controller_M)->solverInfo,
+      &(&six_dof_pos_controller_M)->periodicContStateIndices);
+    rtsiSetPeriodicContStateRangesPtr(&(&six_dof_pos_controller_M)->solverInfo,
+      &(&six_dof_pos_controller_M)->periodicContStateRanges);
+    rtsiSetErrorStatusPtr(&(&six_dof_pos_controller_M)->solverInfo,
+                          (&rtmGetErrorStatus((&six_dof_pos_controller_M))));
+    rtsiSetRTModelPtr(&(&six_dof_pos_controller_M)->solverInfo,
+                      (&six_dof_pos_controller_M));
   }
 
-  rtsiSetSimTimeStep(&six_dof_pos_controller_M->solverInfo, MAJOR_TIME_STEP);
-  six_dof_pos_controller_M->intgData.y = six_dof_pos_controller_M->odeY;
-  six_dof_pos_controller_M->intgData.f[0] = six_dof_pos_controller_M->odeF[0];
-  six_dof_pos_controller_M->intgData.f[1] = six_dof_pos_controller_M->odeF[1];
-  six_dof_pos_controller_M->intgData.f[2] = six_dof_pos_controller_M->odeF[2];
-  six_dof_pos_controller_M->contStates = ((X_six_dof_pos_controller_T *)
+  rtsiSetSimTimeStep(&(&six_dof_pos_controller_M)->solverInfo, MAJOR_TIME_STEP);
+  (&six_dof_pos_controller_M)->intgData.y = (&six_dof_pos_controller_M)->odeY;
+  (&six_dof_pos_controller_M)->intgData.f[0] = (&six_dof_pos_controller_M)->odeF[0];
+  (&six_dof_pos_controller_M)->intgData.f[1] = (&six_dof_pos_controller_M)->odeF[1];
+  (&six_dof_pos_controller_M)->intgData.f[2] = (&six_dof_pos_controller_M)->odeF[2];
+  (&six_dof_pos_controller_M)->contStates = ((X_six_dof_pos_controller_T *)
     &six_dof_pos_controller_X);
-  rtsiSetSolverData(&six_dof_pos_controller_M->solverInfo, (void *)
-                    &six_dof_pos_controller_M->intgData);
-  rtsiSetSolverName(&six_dof_pos_controller_M->solverInfo,"ode3");
-  rtmSetTPtr(six_dof_pos_controller_M, &six_dof_pos_controller_M->Timing.tArray
+  rtsiSetSolverData(&(&six_dof_pos_controller_M)->solverInfo, (void *)
+                    &(&six_dof_pos_controller_M)->intgData);
+  rtsiSetSolverName(&(&six_dof_pos_controller_M)->solverInfo,"ode3");
+  rtmSetTPtr((&six_dof_pos_controller_M), &(&six_dof_pos_controller_M)->Timing.tArray
              [0]);
-  rtmSetTFinal(six_dof_pos_controller_M, -1);
-  six_dof_pos_controller_M->Timing.stepSize0 = 0.008;
+  rtmSetTFinal((&six_dof_pos_controller_M), -1);
+  (&six_dof_pos_controller_M)->Timing.stepSize0 = 0.008;
 
   /* Setup for data logging */
   {
-    static RTWLogInfo rt_DataLoggingInfo;
     rt_DataLoggingInfo.loggingInterval = NULL;
-    six_dof_pos_controller_M->rtwLogInfo = &rt_DataLoggingInfo;
+    (&six_dof_pos_controller_M)->rtwLogInfo = &rt_DataLoggingInfo;
   }
 
   /* Setup for data logging */
   {
-    rtliSetLogXSignalInfo(six_dof_pos_controller_M->rtwLogInfo, (NULL));
-    rtliSetLogXSignalPtrs(six_dof_pos_controller_M->rtwLogInfo, (NULL));
-    rtliSetLogT(six_dof_pos_controller_M->rtwLogInfo, "tout");
-    rtliSetLogX(six_dof_pos_controller_M->rtwLogInfo, "");
-    rtliSetLogXFinal(six_dof_pos_controller_M->rtwLogInfo, "");
-    rtliSetLogVarNameModifier(six_dof_pos_controller_M->rtwLogInfo, "rt_");
-    rtliSetLogFormat(six_dof_pos_controller_M->rtwLogInfo, 4);
-    rtliSetLogMaxRows(six_dof_pos_controller_M->rtwLogInfo, 0);
-    rtliSetLogDecimation(six_dof_pos_controller_M->rtwLogInfo, 1);
-    rtliSetLogY(six_dof_pos_controller_M->rtwLogInfo, "");
-    rtliSetLogYSignalInfo(six_dof_pos_controller_M->rtwLogInfo, (NULL));
-    rtliSetLogYSignalPtrs(six_dof_pos_controller_M->rtwLogInfo, (NULL));
+    rtliSetLogXSignalInfo((&six_dof_pos_controller_M)->rtwLogInfo, (NULL));
+    rtliSetLogXSignalPtrs((&six_dof_pos_controller_M)->rtwLogInfo, (NULL));
+    rtliSetLogT((&six_dof_pos_controller_M)->rtwLogInfo, "tout");
+    rtliSetLogX((&six_dof_pos_controller_M)->rtwLogInfo, "");
+    rtliSetLogXFinal((&six_dof_pos_controller_M)->rtwLogInfo, "");
+    rtliSetLogVarNameModifier((&six_dof_pos_controller_M)->rtwLogInfo, "rt_");
+    rtliSetLogFormat((&six_dof_pos_controller_M)->rtwLogInfo, 4);
+    rtliSetLogMaxRows((&six_dof_pos_controller_M)->rtwLogInfo, 0);
+    rtliSetLogDecimation((&six_dof_pos_controller_M)->rtwLogInfo, 1);
+    rtliSetLogY((&six_dof_pos_controller_M)->rtwLogInfo, "");
+    rtliSetLogYSignalInfo((&six_dof_pos_controller_M)->rtwLogInfo, (NULL));
+    rtliSetLogYSignalPtrs((&six_dof_pos_controller_M)->rtwLogInfo, (NULL));
   }
 
   /* block I/O */
@@ -993,13 +969,14 @@ void six_dof_pos_controller_initialize(void)
                 sizeof(ExtY_six_dof_pos_controller_T));
 
   /* Initialize DataMapInfo substructure containing ModelMap for C API */
-  six_dof_pos_controller_InitializeDataMapInfo();
+  six_dof_pos_controller_InitializeDataMapInfo((&six_dof_pos_controller_M),
+    &six_dof_pos_controller_P, &six_dof_pos_controller_U,
+    &six_dof_pos_controller_Y);
 
-  /* Matfile logging */
-  rt_StartDataLoggingWithStartTime(six_dof_pos_controller_M->rtwLogInfo, 0.0,
-    rtmGetTFinal(six_dof_pos_controller_M),
-    six_dof_pos_controller_M->Timing.stepSize0, (&rtmGetErrorStatus
-    (six_dof_pos_controller_M)));
+  /* Matfile logging: not started. every instance would allocate the log of
+   * tout (and print its buffer size), nothing writes it to a MAT file and
+   * terminate() would have to free it; the instances are many (arms, preview
+   * copies) and short lived */
 
   /* InitializeConditions for Integrator: '<S2>/Integrator1' */
   six_dof_pos_controller_X.Integrator1_CSTATE =
@@ -1147,7 +1124,26 @@ void six_dof_pos_controller_initialize(void)
 }
 
 /* Model terminate function */
-void six_dof_pos_controller_terminate(void)
+void six_dof_pos_controllerModelClass::terminate()
 {
   /* (no terminate code required) */
 }
+
+/* Constructor */
+six_dof_pos_controllerModelClass::six_dof_pos_controllerModelClass() :
+  six_dof_pos_controller_P(six_dof_pos_controller_P_default)
+{
+  /* Currently there is no constructor body generated.*/
+}
+
+/* Destructor */
+six_dof_pos_controllerModelClass::~six_dof_pos_controllerModelClass()
+{
+  /* Currently there is no destructor body generated.*/
+}
+
+/* Real-Time Model get method */
+RT_MODEL_six_dof_pos_controll_T * six_dof_pos_controllerModelClass::getRTM()
+{
+  return (&six_dof_pos_controller_M);
+}
@@ -576,6 +576,8 @@ struct tag_RTM_six_dof_pos_controlle_T {
    */
   struct {
     rtwCAPI_ModelMappingInfo mmi;
+    void* dataAddress[68];
+    int32_T* vardimsAddress[1];
   } DataMapInfo;
 
   /*
@@ -609,79 +611,102 @@ struct tag_RTM_six_dof_pos_controlle_T {
   } Timing;
 };
 
-/* Block parameters (default storage) */
-#ifdef __cplusplus
+/* Function to get C API Model Mapping Static Info */
+extern const rtwCAPI_ModelMappingStaticInfo*
+  six_dof_pos_controller_GetCAPIStaticMap(void);
 
-extern "C" {
+/* Class declaration for model six_dof_pos_controller */
+class six_dof_pos_controllerModelClass {
+  /* public data and function members */
+ public:
+  /* model initialize function */
+  void initialize();
 
-#endif
+  /* model step function */
+  void step();
 
-  extern P_six_dof_pos_controller_T six_dof_pos_controller_P;
+  /* model derivatives function */
+  void derivatives();
 
-#ifdef __cplusplus
+  /* model terminate function */
+  void terminate();
 
-}
-#endif
+  /* Constructor */
+  six_dof_pos_controllerModelClass();
 
-/* Block signals (default storage) */
-extern B_six_dof_pos_controller_T six_dof_pos_controller_B;
+  /* Destructor */
+  ~six_dof_pos_controllerModelClass();
 
-/* Continuous states (default storage) */
-extern X_six_dof_pos_controller_T six_dof_pos_controller_X;
+  /* Root-level structure-based inputs set method */
 
-/* Block states (default storage) */
-extern DW_six_dof_pos_controller_T six_dof_pos_controller_DW;
+  /* Root inports set method */
+  void setExternalInputs(const ExtU_six_dof_pos_controller_T
+    * pExtU_six_dof_pos_controller_T)
+  {
+    six_dof_pos_controller_U = *pExtU_six_dof_pos_controller_T;
+  }
 
-#ifdef __cplusplus
+  /* Root-level structure-based outputs get method */
 
-extern "C" {
+  /* Root outports get method */
+  const ExtY_six_dof_pos_controller_T & getExternalOutputs() const
+  {
+    return six_dof_pos_controller_Y;
+  }
 
-#endif
+  /* Block parameters get method */
+  const P_six_dof_pos_controller_T & getBlockParameters() const
+  {
+    return six_dof_pos_controller_P;
+  }
 
-  /* External inputs (root inport signals with default storage) */
-  extern ExtU_six_dof_pos_controller_T six_dof_pos_controller_U;
+  /* Block parameters set method */
+  void setBlockParameters(const P_six_dof_pos_controller_T
+    * pP_six_dof_pos_controller_T)
+  {
+    six_dof_pos_controller_P = *pP_six_dof_pos_controller_T;
+  }
 
-  /* External outputs (root outports fed by signals with default storage) */
-  extern ExtY_six_dof_pos_controller_T six_dof_pos_controller_Y;
+  /* Real-Time Model get method */
+  RT_MODEL_six_dof_pos_controll_T * getRTM();
 
-#ifdef __cplusplus
+  /* Default block parameters, copied into every instance on construction */
+  static const P_six_dof_pos_controller_T six_dof_pos_controller_P_default;
 
-}
-#endif
+  /* private data and function members */
+ private:
+  /* Tunable parameters */
+  P_six_dof_pos_controller_T six_dof_pos_controller_P;
 
-#ifdef __cplusplus
+  /* Block signals */
+  B_six_dof_pos_controller_T six_dof_pos_controller_B;
 
-extern "C" {
+  /* Block states */
+  DW_six_dof_pos_controller_T six_dof_pos_controller_DW;
 
-#endif
+  /* Block continuous states */
+  X_six_dof_pos_controller_T six_dof_pos_controller_X;
 
-  /* Model entry point functions */
-  extern void six_dof_pos_controller_initialize(void);
-  extern void six_dof_pos_controller_step(void);
-  extern void six_dof_pos_controller_terminate(void);
+  /* External inputs */
+  ExtU_six_dof_pos_controller_T six_dof_pos_controller_U;
 
-#ifdef __cplusplus
+  /* External outputs */
+  ExtY_six_dof_pos_controller_T six_dof_pos_controller_Y;
 
-}
-#endif
+  /* Matfile logging info */
+  RTWLogInfo rt_DataLoggingInfo;
 
-/* Function to get C API Model Mapping Static Info */
-extern const rtwCAPI_ModelMappingStaticInfo*
-  six_dof_pos_controller_GetCAPIStaticMap(void);
-
-/* Real-time Model object */
-#ifdef __cplusplus
-
-extern "C" {
+  /* Real-Time Model */
+  RT_MODEL_six_dof_pos_controll_T six_dof_pos_controller_M;
 
-#endif
-
-  extern RT_MODEL_six_dof_pos_controll_T *const six_dof_pos_controller_M;
-
-#ifdef __cplusplus
+  /* the real-time model points into this instance, it must not be copied */
+  six_dof_pos_controllerModelClass(const six_dof_pos_controllerModelClass &);
+  six_dof_pos_controllerModelClass & operator=(const
+    six_dof_pos_controllerModelClass &);
 
-}
-#endif
+  /* Continuous states update member function*/
+  void rt_ertODEUpdateContinuousStates(RTWSolverInfo *si );
+};
 
 /*-
  * The generated code includes comments that allow you to trace directly
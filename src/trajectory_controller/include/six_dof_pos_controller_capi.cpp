@@ -274,82 +274,88 @@ static const rtwCAPI_ModelParameters rtModelParameters[] = {
 
 #ifndef HOST_CAPI_BUILD
 
-/* Declare Data Addresses statically */
-static void* rtDataAddrMap[] = {
-  &six_dof_pos_controller_P.Integrator2_IC_k,/* 0: Block Parameter */
-  &six_dof_pos_controller_P.Integrator3_IC_i,/* 1: Block Parameter */
-  &six_dof_pos_controller_P.Integrator5_IC_i,/* 2: Block Parameter */
-  &six_dof_pos_controller_P.Delay4_DelayLength_l,/* 3: Block Parameter */
-  &six_dof_pos_controller_P.Delay4_InitialCondition_j,/* 4: Block Parameter */
-  &six_dof_pos_controller_P.Delay5_DelayLength_a,/* 5: Block Parameter */
-  &six_dof_pos_controller_P.Delay5_InitialCondition_g,/* 6: Block Parameter */
-  &six_dof_pos_controller_P.Delay6_DelayLength_c,/* 7: Block Parameter */
-  &six_dof_pos_controller_P.Delay6_InitialCondition_p,/* 8: Block Parameter */
-  &six_dof_pos_controller_P.Integrator_IC,/* 9: Block Parameter */
-  &six_dof_pos_controller_P.Integrator1_IC,/* 10: Block Parameter */
-  &six_dof_pos_controller_P.Integrator4_IC,/* 11: Block Parameter */
-  &six_dof_pos_controller_P.Delay1_DelayLength,/* 12: Block Parameter */
-  &six_dof_pos_controller_P.Delay1_InitialCondition,/* 13: Block Parameter */
-  &six_dof_pos_controller_P.Delay2_DelayLength,/* 14: Block Parameter */
-  &six_dof_pos_controller_P.Delay2_InitialCondition,/* 15: Block Parameter */
-  &six_dof_pos_controller_P.Delay3_DelayLength,/* 16: Block Parameter */
-  &six_dof_pos_controller_P.Delay3_InitialCondition,/* 17: Block Parameter */
-  &six_dof_pos_controller_P.Integrator2_IC,/* 18: Block Parameter */
-  &six_dof_pos_controller_P.Integrator3_IC,/* 19: Block Parameter */
-  &six_dof_pos_controller_P.Integrator5_IC,/* 20: Block Parameter */
-  &six_dof_pos_controller_P.Delay4_DelayLength,/* 21: Block Parameter */
-  &six_dof_pos_controller_P.Delay4_InitialCondition,/* 22: Block Parameter */
-  &six_dof_pos_controller_P.Delay5_DelayLength,/* 23: Block Parameter */
-  &six_dof_pos_controller_P.Delay5_InitialCondition,/* 24: Block Parameter */
-  &six_dof_pos_controller_P.Delay6_DelayLength,/* 25: Block Parameter */
-  &six_dof_pos_controller_P.Delay6_InitialCondition,/* 26: Block Parameter */
-  &six_dof_pos_controller_P.Integrator2_IC_g,/* 27: Block Parameter */
-  &six_dof_pos_controller_P.Integrator3_IC_ix,/* 28: Block Parameter */
-  &six_dof_pos_controller_P.Integrator5_IC_a,/* 29: Block Parameter */
-  &six_dof_pos_controller_P.Delay4_DelayLength_d,/* 30: Block Parameter */
-  &six_dof_pos_controller_P.Delay4_InitialCondition_d,/* 31: Block Parameter */
-  &six_dof_pos_controller_P.Delay5_DelayLength_f,/* 32: Block Parameter */
-  &six_dof_pos_controller_P.Delay5_InitialCondition_n,/* 33: Block Parameter */
-  &six_dof_pos_controller_P.Delay6_DelayLength_n,/* 34: Block Parameter */
-  &six_dof_pos_controller_P.Delay6_InitialCondition_k,/* 35: Block Parameter */
-  &six_dof_pos_controller_P.Integrator2_IC_n,/* 36: Block Parameter */
-  &six_dof_pos_controller_P.Integrator3_IC_j,/* 37: Block Parameter */
-  &six_dof_pos_controller_P.Integrator5_IC_p,/* 38: Block Parameter */
-  &six_dof_pos_controller_P.Delay4_DelayLength_da,/* 39: Block Parameter */
-  &six_dof_pos_controller_P.Delay4_InitialCondition_n,/* 40: Block Parameter */
-  &six_dof_pos_controller_P.Delay5_DelayLength_i,/* 41: Block Parameter */
-  &six_dof_pos_controller_P.Delay5_InitialCondition_i,/* 42: Block Parameter */
-  &six_dof_pos_controller_P.Delay6_DelayLength_p,/* 43: Block Parameter */
-  &six_dof_pos_controller_P.Delay6_InitialCondition_o,/* 44: Block Parameter */
-  &six_dof_pos_controller_P.Integrator2_IC_h,/* 45: Block Parameter */
-  &six_dof_pos_controller_P.Integrator3_IC_a,/* 46: Block Parameter */
-  &six_dof_pos_controller_P.Integrator5_IC_k,/* 47: Block Parameter */
-  &six_dof_pos_controller_P.Delay4_DelayLength_c,/* 48: Block Parameter */
-  &six_dof_pos_controller_P.Delay4_InitialCondition_k,/* 49: Block Parameter */
-  &six_dof_pos_controller_P.Delay5_DelayLength_m,/* 50: Block Parameter */
-  &six_dof_pos_controller_P.Delay5_InitialCondition_o,/* 51: Block Parameter */
-  &six_dof_pos_controller_P.Delay6_DelayLength_j,/* 52: Block Parameter */
-  &six_dof_pos_controller_P.Delay6_InitialCondition_ok,/* 53: Block Parameter */
-  &six_dof_pos_controller_U.pos[0],    /* 54: Root Input */
-  &six_dof_pos_controller_U.vel[0],    /* 55: Root Input */
-  &six_dof_pos_controller_U.acc[0],    /* 56: Root Input */
-  &six_dof_pos_controller_Y.POS[0],    /* 57: Root Output */
-  &six_dof_pos_controller_Y.VEL[0],    /* 58: Root Output */
-  &six_dof_pos_controller_Y.ACC[0],    /* 59: Root Output */
-  &six_dof_pos_controller_Y.JRK[0],    /* 60: Root Output */
-  &six_dof_pos_controller_P.am[0],     /* 61: Model Parameter */
-  &six_dof_pos_controller_P.jm[0],     /* 62: Model Parameter */
-  &six_dof_pos_controller_P.ka[0],     /* 63: Model Parameter */
-  &six_dof_pos_controller_P.kp[0],     /* 64: Model Parameter */
-  &six_dof_pos_controller_P.kv[0],     /* 65: Model Parameter */
-  &six_dof_pos_controller_P.sm[0],     /* 66: Model Parameter */
-  &six_dof_pos_controller_P.vm[0],     /* 67: Model Parameter */
-};
+/* Initialize Data Address */
+static void six_dof_pos_controller_InitializeDataAddr(void* dataAddrMap[],
+  P_six_dof_pos_controller_T *six_dof_pos_controller_P,
+  ExtU_six_dof_pos_controller_T *six_dof_pos_controller_U,
+  ExtY_six_dof_pos_controller_T *six_dof_pos_controller_Y)
+{
+  dataAddrMap[0] = (void*) (&six_dof_pos_controller_P->Integrator2_IC_k); /* 0: Block Parameter */
+  dataAddrMap[1] = (void*) (&six_dof_pos_controller_P->Integrator3_IC_i); /* 1: Block Parameter */
+  dataAddrMap[2] = (void*) (&six_dof_pos_controller_P->Integrator5_IC_i); /* 2: Block Parameter */
+  dataAddrMap[3] = (void*) (&six_dof_pos_controller_P->Delay4_DelayLength_l); /* 3: Block Parameter */
+  dataAddrMap[4] = (void*) (&six_dof_pos_controller_P->Delay4_InitialCondition_j); /* 4: Block Parameter */
+  dataAddrMap[5] = (void*) (&six_dof_pos_controller_P->Delay5_DelayLength_a); /* 5: Block Parameter */
+  dataAddrMap[6] = (void*) (&six_dof_pos_controller_P->Delay5_InitialCondition_g); /* 6: Block Parameter */
+  dataAddrMap[7] = (void*) (&six_dof_pos_controller_P->Delay6_DelayLength_c); /* 7: Block Parameter */
+  dataAddrMap[8] = (void*) (&six_dof_pos_controller_P->Delay6_InitialCondition_p); /* 8: Block Parameter */
+  dataAddrMap[9] = (void*) (&six_dof_pos_controller_P->Integrator_IC); /* 9: Block Parameter */
+  dataAddrMap[10] = (void*) (&six_dof_pos_controller_P->Integrator1_IC); /* 10: Block Parameter */
+  dataAddrMap[11] = (void*) (&six_dof_pos_controller_P->Integrator4_IC); /* 11: Block Parameter */
+  dataAddrMap[12] = (void*) (&six_dof_pos_controller_P->Delay1_DelayLength); /* 12: Block Parameter */
+  dataAddrMap[13] = (void*) (&six_dof_pos_controller_P->Delay1_InitialCondition); /* 13: Block Parameter */
+  dataAddrMap[14] = (void*) (&six_dof_pos_controller_P->Delay2_DelayLength); /* 14: Block Parameter */
+  dataAddrMap[15] = (void*) (&six_dof_pos_controller_P->Delay2_InitialCondition); /* 15: Block Parameter */
+  dataAddrMap[16] = (void*) (&six_dof_pos_controller_P->Delay3_DelayLength); /* 16: Block Parameter */
+  dataAddrMap[17] = (void*) (&six_dof_pos_controller_P->Delay3_InitialCondition); /* 17: Block Parameter */
+  dataAddrMap[18] = (void*) (&six_dof_pos_controller_P->Integrator2_IC); /* 18: Block Parameter */
+  dataAddrMap[19] = (void*) (&six_dof_pos_controller_P->Integrator3_IC); /* 19: Block Parameter */
+  dataAddrMap[20] = (void*) (&six_dof_pos_controller_P->Integrator5_IC); /* 20: Block Parameter */
+  dataAddrMap[21] = (void*) (&six_dof_pos_controller_P->Delay4_DelayLength); /* 21: Block Parameter */
+  dataAddrMap[22] = (void*) (&six_dof_pos_controller_P->Delay4_InitialCondition); /* 22: Block Parameter */
+  dataAddrMap[23] = (void*) (&six_dof_pos_controller_P->Delay5_DelayLength); /* 23: Block Parameter */
+  dataAddrMap[24] = (void*) (&six_dof_pos_controller_P->Delay5_InitialCondition); /* 24: Block Parameter */
+  dataAddrMap[25] = (void*) (&six_dof_pos_controller_P->Delay6_DelayLength); /* 25: Block Parameter */
+  dataAddrMap[26] = (void*) (&six_dof_pos_controller_P->Delay6_InitialCondition); /* 26: Block Parameter */
+  dataAddrMap[27] = (void*) (&six_dof_pos_controller_P->Integrator2_IC_g); /* 27: Block Parameter */
+  dataAddrMap[28] = (void*) (&six_dof_pos_controller_P->Integrator3_IC_ix); /* 28: Block Parameter */
+  dataAddrMap[29] = (void*) (&six_dof_pos_controller_P->Integrator5_IC_a); /* 29: Block Parameter */
+  dataAddrMap[30] = (void*) (&six_dof_pos_controller_P->Delay4_DelayLength_d); /* 30: Block Parameter */
+  dataAddrMap[31] = (void*) (&six_dof_pos_controller_P->Delay4_InitialCondition_d); /* 31: Block Parameter */
+  dataAddrMap[32] = (void*) (&six_dof_pos_controller_P->Delay5_DelayLength_f); /* 32: Block Parameter */
+  dataAddrMap[33] = (void*) (&six_dof_pos_controller_P->Delay5_InitialCondition_n); /* 33: Block Parameter */
+  dataAddrMap[34] = (void*) (&six_dof_pos_controller_P->Delay6_DelayLength_n); /* 34: Block Parameter */
+  dataAddrMap[35] = (void*) (&six_dof_pos_controller_P->Delay6_InitialCondition_k); /* 35: Block Parameter */
+  dataAddrMap[36] = (void*) (&six_dof_pos_controller_P->Integrator2_IC_n); /* 36: Block Parameter */
+  dataAddrMap[37] = (void*) (&six_dof_pos_controller_P->Integrator3_IC_j); /* 37: Block Parameter */
+  dataAddrMap[38] = (void*) (&six_dof_pos_controller_P->Integrator5_IC_p); /* 38: Block Parameter */
+  dataAddrMap[39] = (void*) (&six_dof_pos_controller_P->Delay4_DelayLength_da); /* 39: Block Parameter */
+  dataAddrMap[40] = (void*) (&six_dof_pos_controller_P->Delay4_InitialCondition_n); /* 40: Block Parameter */
+  dataAddrMap[41] = (void*) (&six_dof_pos_controller_P->Delay5_DelayLength_i); /* 41: Block Parameter */
+  dataAddrMap[42] = (void*) (&six_dof_pos_controller_P->Delay5_InitialCondition_i); /* 42: Block Parameter */
+  dataAddrMap[43] = (void*) (&six_dof_pos_controller_P->Delay6_DelayLength_p); /* 43: Block Parameter */
+  dataAddrMap[44] = (void*) (&six_dof_pos_controller_P->Delay6_InitialCondition_o); /* 44: Block Parameter */
+  dataAddrMap[45] = (void*) (&six_dof_pos_controller_P->Integrator2_IC_h); /* 45: Block Parameter */
+  dataAddrMap[46] = (void*) (&six_dof_pos_controller_P->Integrator3_IC_a); /* 46: Block Parameter */
+  dataAddrMap[47] = (void*) (&six_dof_pos_controller_P->Integrator5_IC_k); /* 47: Block Parameter */
+  dataAddrMap[48] = (void*) (&six_dof_pos_controller_P->Delay4_DelayLength_c); /* 48: Block Parameter */
+  dataAddrMap[49] = (void*) (&six_dof_pos_controller_P->Delay4_InitialCondition_k); /* 49: Block Parameter */
+  dataAddrMap[50] = (void*) (&six_dof_pos_controller_P->Delay5_DelayLength_m); /* 50: Block Parameter */
+  dataAddrMap[51] = (void*) (&six_dof_pos_controller_P->Delay5_InitialCondition_o); /* 51: Block Parameter */
+  dataAddrMap[52] = (void*) (&six_dof_pos_controller_P->Delay6_DelayLength_j); /* 52: Block Parameter */
+  dataAddrMap[53] = (void*) (&six_dof_pos_controller_P->Delay6_InitialCondition_ok); /* 53: Block Parameter */
+  dataAddrMap[54] = (void*) (&six_dof_pos_controller_U->pos[0]); /* 54: Root Input */
+  dataAddrMap[55] = (void*) (&six_dof_pos_controller_U->vel[0]); /* 55: Root Input */
+  dataAddrMap[56] = (void*) (&six_dof_pos_controller_U->acc[0]); /* 56: Root Input */
+  dataAddrMap[57] = (void*) (&six_dof_pos_controller_Y->POS[0]); /* 57: Root Output */
+  dataAddrMap[58] = (void*) (&six_dof_pos_controller_Y->VEL[0]); /* 58: Root Output */
+  dataAddrMap[59] = (void*) (&six_dof_pos_controller_Y->ACC[0]); /* 59: Root Output */
+  dataAddrMap[60] = (void*) (&six_dof_pos_controller_Y->JRK[0]); /* 60: Root Output */
+  dataAddrMap[61] = (void*) (&six_dof_pos_controller_P->am[0]); /* 61: Model Parameter */
+  dataAddrMap[62] = (void*) (&six_dof_pos_controller_P->jm[0]); /* 62: Model Parameter */
+  dataAddrMap[63] = (void*) (&six_dof_pos_controller_P->ka[0]); /* 63: Model Parameter */
+  dataAddrMap[64] = (void*) (&six_dof_pos_controller_P->kp[0]); /* 64: Model Parameter */
+  dataAddrMap[65] = (void*) (&six_dof_pos_controller_P->kv[0]); /* 65: Model Parameter */
+  dataAddrMap[66] = (void*) (&six_dof_pos_controller_P->sm[0]); /* 66: Model Parameter */
+  dataAddrMap[67] = (void*) (&six_dof_pos_controller_P->vm[0]); /* 67: Model Parameter */
+}
 
-/* Declare Data Run-Time Dimension Buffer Addresses statically */
-static int32_T* rtVarDimsAddrMap[] = {
-  (NULL)
-};
+/* Initialize Data Run-Time Dimension Buffer Address */
+static void six_dof_pos_controller_InitializeVarDimsAddr(int32_T*
+  vardimsAddrMap[])
+{
+  vardimsAddrMap[0] = (NULL);
+}
 
 #endif
 
@@ -461,7 +467,11 @@ const rtwCAPI_ModelMappingStaticInfo*
 /* Cache pointers into DataMapInfo substructure of RTModel */
 #ifndef HOST_CAPI_BUILD
 
-void six_dof_pos_controller_InitializeDataMapInfo(void)
+void six_dof_pos_controller_InitializeDataMapInfo
+  (RT_MODEL_six_dof_pos_controll_T *const six_dof_pos_controller_M,
+   P_six_dof_pos_controller_T *six_dof_pos_controller_P,
+   ExtU_six_dof_pos_controller_T *six_dof_pos_controller_U,
+   ExtY_six_dof_pos_controller_T *six_dof_pos_controller_Y)
 {
   /* Set C-API version */
   rtwCAPI_SetVersion(six_dof_pos_controller_M->DataMapInfo.mmi, 1);
@@ -473,12 +483,18 @@ void six_dof_pos_controller_InitializeDataMapInfo(void)
   rtwCAPI_SetLoggingStaticMap(six_dof_pos_controller_M->DataMapInfo.mmi, (NULL));
 
   /* Cache C-API Data Addresses into the Real-Time Model Data structure */
+  six_dof_pos_controller_InitializeDataAddr
+    (six_dof_pos_controller_M->DataMapInfo.dataAddress,
+     six_dof_pos_controller_P, six_dof_pos_controller_U,
+     six_dof_pos_controller_Y);
   rtwCAPI_SetDataAddressMap(six_dof_pos_controller_M->DataMapInfo.mmi,
-    rtDataAddrMap);
+    six_dof_pos_controller_M->DataMapInfo.dataAddress);
 
   /* Cache C-API Data Run-Time Dimension Buffer Addresses into the Real-Time Model Data structure */
+  six_dof_pos_controller_InitializeVarDimsAddr
+    (six_dof_pos_controller_M->DataMapInfo.vardimsAddress);
   rtwCAPI_SetVarDimsAddressMap(six_dof_pos_controller_M->DataMapInfo.mmi,
-    rtVarDimsAddrMap);
+    six_dof_pos_controller_M->DataMapInfo.vardimsAddress);
 
   /* Cache the instance C-API logging pointer */
   rtwCAPI_SetInstanceLoggingInfo(six_dof_pos_controller_M->DataMapInfo.mmi,
@@ -22,7 +22,11 @@
 #define RTW_HEADER_six_dof_pos_controller_capi_h
 #include "six_dof_pos_controller.h"
 
-extern void six_dof_pos_controller_InitializeDataMapInfo(void);
+extern void six_dof_pos_controller_InitializeDataMapInfo
+  (RT_MODEL_six_dof_pos_controll_T *const six_dof_pos_controller_M,
+   P_six_dof_pos_controller_T *six_dof_pos_controller_P,
+   ExtU_six_dof_pos_controller_T *six_dof_pos_controller_U,
+   ExtY_six_dof_pos_controller_T *six_dof_pos_controller_Y);
 
 #endif                                 /* RTW_HEADER_six_dof_pos_controller_capi_h */
 
@@ -22,7 +22,8 @@
 #include "six_dof_pos_controller_private.h"
 
 /* Block parameters (default storage) */
-P_six_dof_pos_controller_T six_dof_pos_controller_P = {
+const P_six_dof_pos_controller_T six_dof_pos_controllerModelClass::
+  six_dof_pos_controller_P_default = {
   /* Variable: am
    * Referenced by:
    *   '<S1>/Saturation4'
@@ -41,7 +41,4 @@
 # define rtmSetTPtr(rtm, val)          ((rtm)->Timing.t = (val))
 #endif
 
-/* private model entry point functions */
-extern void six_dof_pos_controller_derivatives(void);
-
 #endif                                 /* RTW_HEADER_six_dof_pos_controller_private_h_ */
@@ -0,0 +1,119 @@
+/**
+\file   spsc_ring.h
+\brief  fixed capacity lock-free ring buffer, one producer thread and one consumer thread.
+ *
+ *  the storage is allocated once in the constructor (capacity rounded up to a power of two), push and pop
+ *  never allocate and never wait: push returns false when the ring is full (backpressure, the record is
+ *  counted as dropped), pop returns false when it is empty.
+ *  the producer and consumer indices are on separate cache lines, each side keeps a cached copy of the
+ *  other index so it reads the shared one only when the ring looks full / empty.
+ *  push_n() writes a block of records in place and publishes them with one store: the consumer sees all of
+ *  them or none, a block that does not fit is dropped whole.
+ *  T has to be copyable without throwing (e.g. a struct of doubles).
+ *
+ *  usage:
+ *      SpscRing<rec> ring(1024);
+ *      producer:  if (!ring.push(r)) ...full...        consumer:  rec r;  while (ring.pop(r)) ...
+ *                 ring.push_n(n, [&](size_t i, rec &r){ r = ...i-th...; });
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+
+
+template <class T>
+class SpscRing
+{
+public:
+    explicit SpscRing(size_t capacity): head_(0), tail_cache_(0), tail_(0), head_cache_(0), pushed_(0), dropped_(0) {
+        cap_ = 1;
+        while (cap_ < capacity)
+            cap_ <<= 1;
+        mask_ = cap_ - 1;
+        buf_.resize(cap_);
+    }
+
+    // ---------- producer ----------
+    // false if the ring is full, the record is dropped then
+    bool push(const T &rec){
+        const size_t t = tail_.load(std::memory_order_relaxed);
+        if (t - head_cache_ == cap_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (t - head_cache_ == cap_) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        buf_[t & mask_] = rec;
+        tail_.store(t + 1, std::memory_order_release);
+        pushed_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // n records at once, fill(i, rec) writes the i-th in its slot (without throwing); false if they do not
+    // all fit, then none is written and the n are counted as dropped
+    template <class F>
+    bool push_n(size_t n, F fill){
+        const size_t t = tail_.load(std::memory_order_relaxed);
+        if (n > cap_ - (t - head_cache_)) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (n > cap_ - (t - head_cache_)) {
+                dropped_.fetch_add(n, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        for (size_t i=0; i<n; i++)
+            fill(i, buf_[(t + i) & mask_]);
+        tail_.store(t + n, std::memory_order_release);
+        pushed_.fetch_add(n, std::memory_order_relaxed);
+        return true;
+    }
+
+    // ---------- consumer ----------
+    // false if the ring is empty
+    bool pop(T &rec){
+        const size_t h = head_.load(std::memory_order_relaxed);
+        if (h == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (h == tail_cache_)
+                return false;
+        }
+        rec = buf_[h & mask_];
+        head_.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // ---------- any thread ----------
+    // records waiting, exact only from the producer or the consumer thread
+    size_t size() const { return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire); }
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return cap_; }
+    uint64_t pushed() const { return pushed_.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    SpscRing(const SpscRing&);
+    SpscRing& operator=(const SpscRing&);
+
+    // consumer side
+    alignas(64) std::atomic<size_t> head_;
+    size_t tail_cache_;
+    // producer side
+    alignas(64) std::atomic<size_t> tail_;
+    size_t head_cache_;
+    std::atomic<uint64_t> pushed_;
+    std::atomic<uint64_t> dropped_;
+    // fixed after construction
+    alignas(64) size_t cap_;
+    size_t mask_;
+    std::vector<T> buf_;
+};
+
+#endif // SPSC_RING_H
@@ -0,0 +1,132 @@
+/**
+\file   trace_log.cpp
+\brief  binary trace of the control loop, see trace_log.h
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#include "trace_log.h"
+#include <time.h>
+#include <string.h>
+#include <sstream>
+#include <chrono>
+
+
+static int64_t now_ns(){
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (int64_t)t.tv_sec*1000000000 + t.tv_nsec;
+}
+
+
+TraceLog::TraceLog(size_t capacity): ring_(capacity), decimation_(0), file_(NULL), start_ns_(0), running_(false){
+}
+
+TraceLog::~TraceLog(){
+    stop();
+}
+
+
+int TraceLog::add_event(const std::string &name, const std::vector<std::string> &fields){
+    event e;
+    e.name = name;
+    e.fields = fields;
+    e.count = 0;
+    events_.push_back(e);
+    return (int)events_.size() - 1;
+}
+
+
+bool TraceLog::start(int decimation, const std::string &file, const std::function<void(const std::string&)> &text_sink){
+    if (running_.load())
+        return true;
+    decimation_ = decimation;
+    text_sink_ = text_sink;
+    start_ns_ = now_ns();
+    bool ok = true;
+    if (!file.empty()) {
+        file_ = fopen(file.c_str(), "wb");
+        if (file_)
+            write_header();
+        else
+            ok = false;
+    }
+    running_.store(true);
+    thread_ = std::thread(&TraceLog::drain_loop, this);
+    return ok;
+}
+
+
+void TraceLog::stop(){
+    if (!running_.exchange(false))
+        return;
+    thread_.join();
+    drain();
+    if (file_) {
+        fclose(file_);
+        file_ = NULL;
+    }
+}
+
+
+bool TraceLog::record(int event, const double *v, int n){
+    trace_record rec;
+    rec.t_ns = now_ns();
+    rec.event = event;
+    rec.n = n < 0 ? 0 : (n < trace_record::max_values ? n : trace_record::max_values);
+    memcpy(rec.v, v, rec.n*sizeof(double));
+    // the whole record goes to the binary file, no stack garbage after the values
+    memset(rec.v + rec.n, 0, (trace_record::max_values - rec.n)*sizeof(double));
+    return ring_.push(rec);
+}
+
+
+void TraceLog::drain_loop(){
+    while (running_.load(std::memory_order_relaxed)) {
+        drain();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+
+void TraceLog::drain(){
+    trace_record rec;
+    while (ring_.pop(rec)) {
+        if (file_)
+            fwrite(&rec, sizeof(rec), 1, file_);
+        if (rec.event >= events_.size())
+            continue;
+        if (decimation_ > 0 && text_sink_ && events_[rec.event].count++ % decimation_ == 0)
+            text_sink_(format(rec));
+    }
+    if (file_)
+        fflush(file_);
+}
+
+
+void TraceLog::write_header(){
+    const uint32_t head[3] = {(uint32_t)sizeof(trace_record), (uint32_t)trace_record::max_values, (uint32_t)events_.size()};
+    fwrite("JLCTRACE", 8, 1, file_);
+    fwrite(head, sizeof(head), 1, file_);
+    for (size_t i=0; i<events_.size(); i++) {
+        const uint32_t len = events_[i].name.size();
+        fwrite(&len, sizeof(len), 1, file_);
+        fwrite(events_[i].name.data(), len, 1, file_);
+    }
+}
+
+
+// "<name>  <field> <value>  ...   <value>  (t= <s since start>)"
+std::string TraceLog::format(const trace_record &rec) const {
+    const event &e = events_[rec.event];
+    std::ostringstream line;
+    line << e.name;
+    for (uint32_t i=0; i<rec.n; i++) {
+        if (i < e.fields.size())
+            line << "  " << e.fields[i] << " " << rec.v[i];
+        else
+            line << "   " << rec.v[i];
+    }
+    line << "  (t= " << 1e-9*(rec.t_ns - start_ns_) << ")";
+    return line.str();
+}
@@ -0,0 +1,95 @@
+/**
+\file   trace_log.h
+\brief  binary trace of the control loop, formatted and written by a background thread.
+ *
+ *  the control thread records raw doubles with a timestamp (CLOCK_MONOTONIC) into a fixed capacity
+ *  SpscRing (spsc_ring.h): no formatting, no iostream, no lock, no allocation. a full ring drops the record
+ *  (counted in n_dropped()).
+ *  the drain thread started by start() takes the records every 10 ms and
+ *    - gives every decimation-th record of each event as a text line to the sink (e.g. ROS_INFO),
+ *      "<name>  <field> <value>  <field> <value> ...  (t= <s after start>)"  (values without a field are only
+ *      separated by spaces)
+ *    - writes all the records to a binary file, if a path is given.
+ *  binary file (native endianness):
+ *      "JLCTRACE", uint32 record size, uint32 max_values, uint32 number of events,
+ *      per event: uint32 name length, name,   then the trace_record structs one after the other.
+ *  record() is called from one thread only (the control loop). events are added before start().
+ *  no ros dependency.
+ *
+ *  usage:
+ *      TraceLog trace;
+ *      const int step = trace.add_event("STEP:", {"inpos=", "outpos="});
+ *      trace.start(25, "", [](const std::string &line){ puts(line.c_str()); });
+ *      loop: double v[2] = {...};  trace.record(step, v, 2);
+ *      trace.stop();
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef TRACE_LOG_H
+#define TRACE_LOG_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include "spsc_ring.h"
+
+
+struct trace_record {
+    static const int max_values = 16;   // more values given to record() are cut
+    int64_t t_ns;                       // CLOCK_MONOTONIC
+    uint32_t event;
+    uint32_t n;                         // values used in v
+    double v[max_values];
+};
+
+
+class TraceLog
+{
+public:
+    explicit TraceLog(size_t capacity = 1024);
+    ~TraceLog();
+
+    // before start(): registers an event with the labels of its first values, returns its id
+    int add_event(const std::string &name, const std::vector<std::string> &fields = std::vector<std::string>());
+
+    // starts the drain thread: every decimation-th record of an event to text_sink (decimation 0: no text),
+    // all the records to file (empty: no file). false if the file could not be opened, the text still works
+    bool start(int decimation, const std::string &file, const std::function<void(const std::string&)> &text_sink);
+    // drains what is left and ends the thread
+    void stop();
+
+    // control thread: n values of event with the current time (n cut to [0, max_values]), false if the ring
+    // is full
+    bool record(int event, const double *v, int n);
+
+    uint64_t n_recorded() const { return ring_.pushed(); }
+    uint64_t n_dropped() const { return ring_.dropped(); }
+
+private:
+    struct event {
+        std::string name;
+        std::vector<std::string> fields;
+        uint64_t count;
+    };
+
+    void drain_loop();
+    void drain();
+    void write_header();
+    std::string format(const trace_record &rec) const;
+
+    SpscRing<trace_record> ring_;
+    std::vector<event> events_;
+    int decimation_;
+    FILE *file_;
+    std::function<void(const std::string&)> text_sink_;
+    int64_t start_ns_;
+    std::atomic<bool> running_;
+    std::thread thread_;
+};
+
+#endif // TRACE_LOG_H
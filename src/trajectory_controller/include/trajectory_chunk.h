@@ -0,0 +1,86 @@
+/**
+\file   trajectory_chunk.h
+\brief  trajectories sent to the controllers in bulk: a trajectory_msgs/JointTrajectory per chunk on
+        "/cmd_traj", each one acknowledged on "/cmd_traj_ack" (custom_msgs/traj_ack_msg).
+ *
+ *  a chunk is checked once when it arrives (check_chunk: points with N finite positions, N joint names or
+ *  none), then queued in one block by the controller, so the order of its waypoints is the order of its
+ *  points whatever the transport. the ack repeats the header of the chunk, says whether all its points were
+ *  queued (none are otherwise: invalid, or more than the free space of the queue, then resend it later)
+ *  and how many waypoints are pending, so a sender can send the next chunk when the previous one is acked.
+ *
+ *  usage (callback of /cmd_traj):
+ *      std::string error;
+ *      const bool ok = check_chunk(*msg, N, error) && queue(...);
+ *      acks_.publish(*msg, ok, n_pending, capacity, error);
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef TRAJECTORY_CHUNK_H
+#define TRAJECTORY_CHUNK_H
+
+#include <math.h>
+#include <string>
+#include "ros/ros.h"
+#include "trajectory_msgs/JointTrajectory.h"
+#include "custom_msgs/traj_ack_msg.h"
+
+
+// true if every point of traj has n_joints finite positions (and traj n_joints names or none), else
+// the reason in error
+inline bool check_chunk(const trajectory_msgs::JointTrajectory &traj, int n_joints, std::string &error){
+    if (traj.points.empty()) {
+        error = "no points";
+        return false;
+    }
+    if (!traj.joint_names.empty() && (int)traj.joint_names.size() != n_joints) {
+        error = std::to_string(traj.joint_names.size()) + " joint names, the controller has "
+                + std::to_string(n_joints) + " joints";
+        return false;
+    }
+    for (size_t pt=0; pt<traj.points.size(); pt++) {
+        const std::vector<double> &pos = traj.points[pt].positions;
+        if ((int)pos.size() != n_joints) {
+            error = "point " + std::to_string(pt) + " has " + std::to_string(pos.size()) + " positions, expected "
+                    + std::to_string(n_joints);
+            return false;
+        }
+        for (int jt=0; jt<n_joints; jt++)
+            if (!isfinite(pos[jt])) {
+                error = "point " + std::to_string(pt) + " joint " + std::to_string(jt) + " not finite";
+                return false;
+            }
+    }
+    return true;
+}
+
+
+// publisher of the acks, counts the chunks
+class ChunkAcks
+{
+public:
+    explicit ChunkAcks(ros::NodeHandle &nh): n_chunks_(0) {
+        pub_ = nh.advertise<custom_msgs::traj_ack_msg>("/cmd_traj_ack", 100);
+    }
+
+    void publish(const trajectory_msgs::JointTrajectory &traj, bool accepted, size_t n_pending, size_t capacity,
+                 const std::string &error){
+        custom_msgs::traj_ack_msgPtr ack(new custom_msgs::traj_ack_msg);
+        ack->header = traj.header;
+        ack->chunk = n_chunks_++;
+        ack->accepted = accepted;
+        ack->n_points = traj.points.size();
+        ack->n_pending = n_pending;
+        ack->capacity = capacity;
+        if (!accepted)
+            ack->error = error;
+        pub_.publish(ack);
+    }
+
+private:
+    ros::Publisher pub_;
+    uint32_t n_chunks_;
+};
+
+#endif // TRAJECTORY_CHUNK_H
@@ -0,0 +1,239 @@
+/**
+\file   trajectory_file.cpp
+\brief  binary trajectory file, see trajectory_file.h
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#include "trajectory_file.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+static const uint64_t column_align = 64;
+
+static uint64_t align_up(uint64_t x){
+    return (x + column_align - 1) & ~(column_align - 1);
+}
+
+
+TrajectoryFile::TrajectoryFile(): map_(NULL), map_size_(0), header_(NULL) {}
+
+
+TrajectoryFile::~TrajectoryFile(){
+    close();
+}
+
+
+void TrajectoryFile::close(){
+    if (map_)
+        munmap(map_, map_size_);
+    map_ = NULL;
+    map_size_ = 0;
+    header_ = NULL;
+    names_.clear();
+}
+
+
+bool TrajectoryFile::fail(const std::string &what){
+    error_ = path_ + ": " + what;
+    close();
+    return false;
+}
+
+
+bool TrajectoryFile::open(const std::string &path){
+    close();
+    path_ = path;
+    error_.clear();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return fail(strerror(errno));
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        const int err = errno;
+        ::close(fd);
+        return fail(strerror(err));
+    }
+    if ((size_t)st.st_size < sizeof(traj_file_header)) {
+        ::close(fd);
+        return fail("too short for a trajectory file");
+    }
+    map_size_ = st.st_size;
+    map_ = mmap(NULL, map_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);   // the mapping keeps the file
+    if (map_ == MAP_FAILED) {
+        map_ = NULL;
+        return fail(std::string("mmap: ") + strerror(errno));
+    }
+    header_ = (const traj_file_header*)map_;
+    if (!check_header(map_size_))
+        return false;
+    madvise(map_, map_size_, MADV_SEQUENTIAL);
+    return true;
+}
+
+
+bool TrajectoryFile::check_header(size_t size){
+    const traj_file_header &h = *header_;
+    if (memcmp(h.magic, TRAJ_FILE_MAGIC, sizeof(TRAJ_FILE_MAGIC)) != 0)
+        return fail("not a trajectory file");
+    if (h.version != TRAJ_FILE_VERSION)
+        return fail("version " + std::to_string(h.version) + ", this build reads version "
+                    + std::to_string(TRAJ_FILE_VERSION));
+    if (h.header_size != sizeof(traj_file_header))
+        return fail("header size " + std::to_string(h.header_size));
+    if (h.file_size != size)
+        return fail("file size " + std::to_string(size) + " instead of " + std::to_string(h.file_size)
+                    + " (truncated?)");
+    if (h.n_joints < 1 || h.n_joints > TRAJ_FILE_MAX_JOINTS)
+        return fail("number of joints " + std::to_string(h.n_joints));
+    if (h.n_points < 1 || h.n_points > size/sizeof(double))
+        return fail("number of points " + std::to_string(h.n_points));
+
+    // every region after the header and inside the file, the columns aligned for double
+    const uint64_t column_size = h.n_points*sizeof(double);
+    if (h.names_offset < h.header_size || h.names_size < h.n_joints || h.names_offset > size
+        || h.names_size > size - h.names_offset)
+        return fail("joint names outside of the file");
+    if (h.time_offset < h.header_size || h.time_offset % sizeof(double) || h.time_offset > size
+        || column_size > size - h.time_offset)
+        return fail("time column outside of the file");
+    if (!h.column_offset[TRAJ_POS])
+        return fail("no positions");
+    for (int c=0; c<N_TRAJ_COLUMNS; c++) {
+        const uint64_t offset = h.column_offset[c];
+        if (offset && (offset < h.header_size || offset % sizeof(double) || offset > size
+                       || (size - offset)/column_size < h.n_joints))
+            return fail("joint columns outside of the file");
+    }
+
+    const char *names = (const char*)map_ + h.names_offset;
+    if (names[h.names_size - 1] != '\0')
+        return fail("joint names not ended");
+    for (const char *s = names; s < names + h.names_size; s += strlen(s) + 1)
+        names_.push_back(s);
+    if (names_.size() != h.n_joints)
+        return fail(std::to_string(names_.size()) + " joint names for " + std::to_string(h.n_joints) + " joints");
+    return true;
+}
+
+
+bool TrajectoryFile::verify(){
+    if (!header_)
+        return fail("not open");
+    const uint32_t crc = crc32(0, (const char*)map_ + header_->header_size, map_size_ - header_->header_size);
+    if (crc != header_->crc32)
+        return fail("crc32 differs, the file is damaged");
+
+    const size_t n = header_->n_points;
+    const double *t = time();
+    for (size_t pt=0; pt<n; pt++)
+        if (!isfinite(t[pt]) || (pt && t[pt] < t[pt-1]))
+            return fail("time of point " + std::to_string(pt) + " is not finite or goes back");
+    for (int c=0; c<N_TRAJ_COLUMNS; c++) {
+        if (!header_->column_offset[c])
+            continue;
+        const double *v = column(header_->column_offset[c]);
+        for (size_t i=0; i<n*header_->n_joints; i++)
+            if (!isfinite(v[i]))
+                return fail("value not finite, joint " + std::to_string(i/n) + " point " + std::to_string(i%n));
+    }
+    return true;
+}
+
+
+bool TrajectoryFile::write(const std::string &path, const std::vector<std::string> &joint_names, size_t n_points,
+                           const double *time, const double *pos, const double *vel, const double *acc,
+                           std::string *error){
+    const size_t n_joints = joint_names.size();
+    if (n_joints < 1 || n_joints > TRAJ_FILE_MAX_JOINTS || n_points < 1 || !time || !pos) {
+        if (error)
+            *error = path + ": needs 1.." + std::to_string(TRAJ_FILE_MAX_JOINTS)
+                     + " joints, points, times and positions";
+        return false;
+    }
+
+    traj_file_header h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, TRAJ_FILE_MAGIC, sizeof(TRAJ_FILE_MAGIC));
+    h.version = TRAJ_FILE_VERSION;
+    h.header_size = sizeof(h);
+    h.n_joints = n_joints;
+    h.n_points = n_points;
+
+    std::string names;
+    for (size_t jt=0; jt<n_joints; jt++)
+        names.append(joint_names[jt].c_str(), joint_names[jt].size() + 1);
+    h.names_offset = sizeof(h);
+    h.names_size = names.size();
+
+    const double *columns[N_TRAJ_COLUMNS] = {pos, vel, acc};
+    const uint64_t column_size = n_points*sizeof(double);
+    uint64_t end = align_up(h.names_offset + h.names_size);
+    h.time_offset = end;
+    end = align_up(end + column_size);
+    for (int c=0; c<N_TRAJ_COLUMNS; c++) {
+        if (!columns[c])
+            continue;
+        h.column_offset[c] = end;
+        end = align_up(end + n_joints*column_size);
+    }
+    h.file_size = end;
+
+    // the body in memory for its crc, then one write
+    std::vector<char> body(h.file_size - sizeof(h), 0);
+    memcpy(&body[h.names_offset - sizeof(h)], names.data(), names.size());
+    memcpy(&body[h.time_offset - sizeof(h)], time, column_size);
+    for (int c=0; c<N_TRAJ_COLUMNS; c++)
+        if (columns[c])
+            memcpy(&body[h.column_offset[c] - sizeof(h)], columns[c], n_joints*column_size);
+    h.crc32 = crc32(0, body.data(), body.size());
+
+    const std::string tmp = path + ".tmp";
+    FILE *f = fopen(tmp.c_str(), "wb");
+    if (!f) {
+        if (error)
+            *error = tmp + ": " + strerror(errno);
+        return false;
+    }
+    const bool written = fwrite(&h, sizeof(h), 1, f) == 1 && fwrite(body.data(), 1, body.size(), f) == body.size();
+    if (fclose(f) != 0 || !written || rename(tmp.c_str(), path.c_str()) != 0) {
+        if (error)
+            *error = path + ": " + strerror(errno);
+        unlink(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+
+// table of the crc32, built at the first use (thread safe static)
+struct crc32_table {
+    uint32_t v[256];
+    crc32_table(){
+        for (uint32_t i=0; i<256; i++) {
+            uint32_t c = i;
+            for (int k=0; k<8; k++)
+                c = c & 1 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+            v[i] = c;
+        }
+    }
+};
+
+
+uint32_t TrajectoryFile::crc32(uint32_t crc, const void *data, size_t size){
+    static const crc32_table table;
+    const unsigned char *p = (const unsigned char*)data;
+    crc = ~crc;
+    for (size_t i=0; i<size; i++)
+        crc = table.v[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+    return ~crc;
+}
@@ -0,0 +1,124 @@
+/**
+\file   trajectory_file.h
+\brief  binary trajectory file (.traj): versioned, column-oriented, mapped in memory and validated at load.
+ *
+ *  replaces the headers generated from the toppra yaml files (generate_traj()): a new trajectory is a new
+ *  file, written by scripts/trajectory_converter.py from a yaml JointTrajectory or a bag, no rebuild.
+ *  layout (little endian, every offset from the start of the file):
+ *      traj_file_header        128 bytes, magic "JLCTRAJ", version, sizes and offsets below
+ *      joint names             n_joints strings, each ended by '\0'
+ *      time                    n_points doubles, time_from_start [s]      (64 byte aligned)
+ *      pos [, vel] [, acc]     n_joints columns of n_points doubles each  (64 byte aligned blocks),
+ *                              value of joint jt at point pt: column[jt*n_points + pt]
+ *  open() maps the file and checks the header, the sizes and the offsets against the file size: a few
+ *  syscalls whatever the number of points, the pages are read when the columns are used. verify() also
+ *  checks the crc32 (zlib) of everything after the header and that the values are finite and the times
+ *  non-decreasing, it reads the whole file. no ros dependency.
+ *
+ *  usage:
+ *      TrajectoryFile traj;
+ *      if (!traj.open(path) || !traj.verify())  error(traj.error());
+ *      const double *p0 = traj.pos(0);  for pt < traj.n_points():  p0[pt], traj.time()[pt]
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef TRAJECTORY_FILE_H
+#define TRAJECTORY_FILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+
+#define TRAJ_FILE_MAGIC "JLCTRAJ"
+#define TRAJ_FILE_VERSION 1
+#define TRAJ_FILE_MAX_JOINTS 64
+
+// columns of joint values
+enum traj_column {
+    TRAJ_POS = 0,
+    TRAJ_VEL,
+    TRAJ_ACC,
+    N_TRAJ_COLUMNS
+};
+
+
+struct traj_file_header {
+    char magic[8];                          // "JLCTRAJ\0"
+    uint32_t version;                       // TRAJ_FILE_VERSION
+    uint32_t header_size;                   // sizeof(traj_file_header)
+    uint32_t n_joints;
+    uint32_t reserved0;
+    uint64_t n_points;
+    uint64_t file_size;
+    uint64_t names_offset;
+    uint64_t names_size;                    // with the '\0's
+    uint64_t time_offset;
+    uint64_t column_offset[N_TRAJ_COLUMNS]; // 0: column not in the file (pos is always there)
+    uint32_t crc32;                         // of the bytes after the header
+    uint32_t reserved1;
+    uint64_t reserved[4];
+};
+
+
+class TrajectoryFile
+{
+public:
+    TrajectoryFile();
+    ~TrajectoryFile();
+
+    // maps the file and checks its header, false with error() if it is not a valid trajectory file
+    bool open(const std::string &path);
+    // checks the crc32 and the values of an open file, false with error()
+    bool verify();
+    void close();
+
+    bool is_open() const { return header_ != NULL; }
+    const std::string& error() const { return error_; }
+
+    int n_joints() const { return header_->n_joints; }
+    size_t n_points() const { return header_->n_points; }
+    const std::string& joint_name(int jt) const { return names_[jt]; }
+    // time_from_start of every point [s]
+    const double* time() const { return column(header_->time_offset); }
+    // n_points values of joint jt, NULL for a column that is not in the file
+    const double* pos(int jt) const { return joint_column(TRAJ_POS, jt); }
+    const double* vel(int jt) const { return joint_column(TRAJ_VEL, jt); }
+    const double* acc(int jt) const { return joint_column(TRAJ_ACC, jt); }
+
+    // writes a trajectory file, the joint columns one after the other (value of jt at pt: [jt*n_points + pt]),
+    // vel and acc may be NULL. written to path.tmp then renamed, so a file mapped by a reader stays valid.
+    // false with the reason in error
+    static bool write(const std::string &path, const std::vector<std::string> &joint_names, size_t n_points,
+                      const double *time, const double *pos, const double *vel, const double *acc,
+                      std::string *error);
+
+    // crc32 of zlib (polynomial 0xedb88320), crc 0 to start
+    static uint32_t crc32(uint32_t crc, const void *data, size_t size);
+
+private:
+    TrajectoryFile(const TrajectoryFile&);
+    TrajectoryFile& operator=(const TrajectoryFile&);
+
+    bool fail(const std::string &what);
+    bool check_header(size_t size);
+
+    const double* column(uint64_t offset) const {
+        return (const double*)((const char*)map_ + offset);
+    }
+    const double* joint_column(traj_column c, int jt) const {
+        const uint64_t offset = header_->column_offset[c];
+        return offset ? column(offset) + (size_t)jt*header_->n_points : NULL;
+    }
+
+    void *map_;
+    size_t map_size_;
+    const traj_file_header *header_;
+    std::vector<std::string> names_;
+    std::string path_;
+    std::string error_;
+};
+
+#endif // TRAJECTORY_FILE_H
@@ -0,0 +1,112 @@
+/**
+\file   waypoint_sequencer.h
+\brief  waypoint queue of controller_approaching_each_waypoint, shared with the offline batch_simulator.
+ *
+ *  the waypoints are approached one after the other: the setpoint moves to the next waypoint only when
+ *  every joint is within cnt of the current one, otherwise the current waypoint is kept.
+ *  the first setpoint is zero for all the joints. no ros dependency.
+ *  blending (set_blend_radius(r), update with the velocities): the next waypoint is taken as soon as every
+ *  joint is within r of the current one and not moving away from it (or within cnt), so the joints pass
+ *  near the intermediate waypoints, at most about r from them, instead of slowing down to cnt at each.
+ *  the last waypoint is still approached within cnt. the controller keeps its vm/am/jm limits whatever the
+ *  setpoint, the blending only changes when it moves on. r <= cnt (default 0) is the plain behavior.
+ *
+ *  usage:
+ *      WaypointSequencer<6> seq(cnt, 1024);
+ *      seq.push(wpt);  ...
+ *      loop: const double *setpoint = seq.update(crnt_pos);  step the controller to setpoint ...
+ *      or:   seq.set_blend_radius(0.05);  loop: const double *setpoint = seq.update(crnt_pos, crnt_vel);  ...
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef WAYPOINT_SEQUENCER_H
+#define WAYPOINT_SEQUENCER_H
+
+#include <string.h>
+#include <math.h>
+#include "spsc_ring.h"
+
+
+template <int N>
+class WaypointSequencer
+{
+public:
+    struct waypoint {
+        double pos[N];
+    };
+
+    WaypointSequencer(double cnt, size_t capacity): cnt_(cnt), blend_radius_(cnt), pending_(capacity) {
+        memset(&target_, 0, sizeof(target_));
+    }
+
+    // blend radius of update(crnt_pos, crnt_vel), r <= cnt: waypoints reached within cnt
+    void set_blend_radius(double r){ blend_radius_ = r > cnt_ ? r : cnt_; }
+    double blend_radius() const { return blend_radius_; }
+
+    // ---------- producer ----------
+    // queue a waypoint of N positions, false if the queue is full
+    bool push(const double *wpt){
+        waypoint w;
+        memcpy(w.pos, wpt, sizeof(w.pos));
+        return pending_.push(w);
+    }
+
+    // queue n waypoints at once, wpt(i) gives the N positions of the i-th; false (none queued) if the n do
+    // not fit in the queue
+    template <class F>
+    bool push_n(size_t n, F wpt){
+        return pending_.push_n(n, [&wpt](size_t i, waypoint &w){ memcpy(w.pos, wpt(i), sizeof(w.pos)); });
+    }
+
+    // ---------- consumer ----------
+    // every joint within cnt of the current waypoint
+    bool reached(const double *crnt_pos) const {
+        for (int jt=0; jt<N; jt++)
+            if (fabs(crnt_pos[jt] - target_.pos[jt]) > cnt_)
+                return false;
+        return true;
+    }
+
+    // every joint within cnt of the current waypoint, or within the blend radius and not moving away from it
+    bool passing(const double *crnt_pos, const double *crnt_vel) const {
+        for (int jt=0; jt<N; jt++) {
+            const double d = target_.pos[jt] - crnt_pos[jt];
+            if (fabs(d) > cnt_ && (fabs(d) > blend_radius_ || d*crnt_vel[jt] < 0))
+                return false;
+        }
+        return true;
+    }
+
+    // moves to the next waypoint if the current one is reached, returns the setpoint (N positions)
+    const double* update(const double *crnt_pos){
+        if (reached(crnt_pos))
+            pending_.pop(target_);
+        return target_.pos;
+    }
+
+    // same with blending: moves on when the current waypoint is passed, the last one is reached
+    const double* update(const double *crnt_pos, const double *crnt_vel){
+        if (passing(crnt_pos, crnt_vel))
+            pending_.pop(target_);
+        return target_.pos;
+    }
+
+    // the last waypoint is the setpoint and it is reached
+    bool finished(const double *crnt_pos) const { return pending_.empty() && reached(crnt_pos); }
+
+    const double* setpoint() const { return target_.pos; }
+
+    // ---------- any thread ----------
+    size_t n_pending() const { return pending_.size(); }
+    size_t capacity() const { return pending_.capacity(); }
+    uint64_t n_dropped() const { return pending_.dropped(); }
+
+private:
+    double cnt_;
+    double blend_radius_;
+    waypoint target_;
+    SpscRing<waypoint> pending_;
+};
+
+#endif // WAYPOINT_SEQUENCER_H
@@ -0,0 +1,141 @@
+#!/usr/bin/env python
+"""
+converts a trajectory to the binary trajectory file (.traj) read by cmd_pos_publisher, see
+include/trajectory_file.h for the layout.
+
+    trajectory_converter.py <in.yaml | in.bag> [-o out.traj] [-t topic]
+
+yaml: a trajectory_msgs/JointTrajectory as written by toppra or rostopic echo (joint_names, points with
+      positions, velocities, accelerations and time_from_start as {secs, nsecs} or seconds).
+bag:  the last trajectory_msgs/JointTrajectory message of the bag (or of -t topic), or else the
+      std_msgs/Float64MultiArray messages of /cmd_pos (or -t topic) one point each, timed by their arrival.
+the output is in.traj by default.
+"""
+
+import argparse
+import array
+import os
+import struct
+import sys
+import zlib
+
+import yaml
+
+MAGIC = b"JLCTRAJ\0"
+VERSION = 1
+HEADER = struct.Struct("<8sIIII QQQQQ QQQ II 4Q")   # traj_file_header
+MAX_JOINTS = 64
+ALIGN = 64
+
+
+def align_up(x):
+    return (x + ALIGN - 1) & ~(ALIGN - 1)
+
+
+def to_seconds(t):
+    if isinstance(t, dict):
+        return t.get("secs", 0) + 1e-9*t.get("nsecs", 0)
+    if hasattr(t, "to_sec"):
+        return t.to_sec()
+    return float(t)
+
+
+def doubles(values):
+    a = array.array("d", values)
+    if sys.byteorder != "little":
+        a.byteswap()
+    return a.tostring() if sys.version_info[0] < 3 else a.tobytes()
+
+
+def write_traj(path, joint_names, time, columns):
+    """columns: [pos, vel, acc], each a list of points of n_joints values or None (pos is needed)"""
+    n_joints, n_points = len(joint_names), len(time)
+    if not 1 <= n_joints <= MAX_JOINTS or not n_points or not columns[0]:
+        raise ValueError("needs 1..%d joints, points and positions" % MAX_JOINTS)
+    for c in columns:
+        if c and any(len(p) != n_joints for p in c):
+            raise ValueError("a point has not %d values" % n_joints)
+
+    names = b"".join(n.encode("utf-8") + b"\0" for n in joint_names)
+    names_offset = HEADER.size
+    time_offset = align_up(names_offset + len(names))
+    end = align_up(time_offset + 8*n_points)
+    offsets = []
+    for c in columns:
+        offsets.append(end if c else 0)
+        if c:
+            end = align_up(end + 8*n_points*n_joints)
+
+    body = bytearray(end - HEADER.size)
+    def put(offset, data):
+        body[offset - HEADER.size:offset - HEADER.size + len(data)] = data
+    put(names_offset, names)
+    put(time_offset, doubles(time))
+    for c, offset in zip(columns, offsets):
+        if c:   # column of joint jt after the one of jt-1
+            put(offset, doubles(p[jt] for jt in range(n_joints) for p in c))
+    crc = zlib.crc32(bytes(body)) & 0xffffffff
+
+    header = HEADER.pack(MAGIC, VERSION, HEADER.size, n_joints, 0, n_points, end, names_offset, len(names),
+                         time_offset, offsets[0], offsets[1], offsets[2], crc, 0, 0, 0, 0, 0)
+    with open(path + ".tmp", "wb") as f:
+        f.write(header)
+        f.write(body)
+    os.rename(path + ".tmp", path)
+
+
+def from_yaml(path):
+    with open(path) as f:
+        msg = yaml.safe_load(f)
+    points = msg["points"]
+    time = [to_seconds(p["time_from_start"]) for p in points]
+    columns = [[p.get(k) for p in points] for k in ("positions", "velocities", "accelerations")]
+    columns = [c if all(c) else None for c in columns]
+    return msg["joint_names"], time, columns
+
+
+def from_bag(path, topic):
+    import rosbag
+    with rosbag.Bag(path) as bag:
+        types = bag.get_type_and_topic_info().topics
+        traj_topics = [t for t in types if types[t].msg_type == "trajectory_msgs/JointTrajectory"]
+        if topic in traj_topics or (topic is None and traj_topics):
+            msg = None
+            for _, msg, _ in bag.read_messages(topics=[topic or traj_topics[0]]):
+                pass
+            points = msg.points
+            time = [p.time_from_start.to_sec() for p in points]
+            columns = [[getattr(p, k) for p in points] for k in ("positions", "velocities", "accelerations")]
+            columns = [c if all(c) else None for c in columns]
+            return list(msg.joint_names), time, columns
+
+        pos, time = [], []
+        for _, msg, t in bag.read_messages(topics=[topic or "/cmd_pos"]):
+            if not time:
+                t0 = t
+            pos.append(list(msg.data))
+            time.append((t - t0).to_sec())
+        if not pos:
+            raise ValueError("no JointTrajectory and no messages on %s" % (topic or "/cmd_pos"))
+        names = ["joint_%d" % (jt + 1) for jt in range(len(pos[0]))]
+        return names, time, [pos, None, None]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="yaml or bag trajectory to a binary trajectory file")
+    parser.add_argument("input", help="JointTrajectory .yaml or .bag")
+    parser.add_argument("-o", "--output", help="output .traj (default: input with .traj)")
+    parser.add_argument("-t", "--topic", help="topic of the bag")
+    args = parser.parse_args()
+
+    if args.input.endswith(".bag"):
+        names, time, columns = from_bag(args.input, args.topic)
+    else:
+        names, time, columns = from_yaml(args.input)
+    output = args.output or args.input.rsplit(".", 1)[0] + ".traj"
+    write_traj(output, names, time, columns)
+    print("%s: %d joints, %d points, %.3f s" % (output, len(names), len(time), time[-1] - time[0]))
+
+
+if __name__ == "__main__":
+    main()
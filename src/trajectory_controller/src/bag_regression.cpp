@@ -0,0 +1,443 @@
+/**
+\file   bag_regression.cpp
+\brief  golden trajectory regression: replays the commands of recorded bags through the controller library and
+        compares the outputs with the recorded states.
+ *
+ *  usage: bag_regression [-s solver=ode3] [-i isa=best] [-r rate=125] [-t pos,vel,acc,jrk] [-p name=value]
+ *                        (-m list_file | <bag> [bag ...])
+ *  the node of a bag is found from its state topic:
+ *      /state_each_waypts   controller_approaching_each_waypoint, commands /cmd_pos
+ *      /state_last_waypts   controller_approaching_last_waypoint, commands /cmd_pos
+ *      /out_state           velocity_jogging_node,                commands /cmd_vel
+ *  every recorded state is one loop of the node: a command is given to the loop of the first state recorded
+ *  at least 0.3 ms after it, then the loop is run like the node does (same limits, gains, waypoint
+ *  sequencing and jogging limits) but as fast as the cpu allows, and its state is compared with the recorded one.
+ *  the controller_approaching_each_waypoint of the bags queued a zero waypoint before the first /cmd_pos,
+ *  the replay does the same.
+ *  some bags were recorded with other limits or gains than the nodes have now, -p sm|vm|am|jm|kp|kv|ka=value
+ *  sets one for all the bags, like -p cmd_vel_max=value (the clamp of /cmd_vel: sm in the velocity node, no
+ *  clamp, inf, in older ones). the list file has one bag per line (relative to the list file) followed by its
+ *  own name=value settings, '#' starts a comment: ../../../bags/regression_bags.txt has the bags of the
+ *  repository with the settings they were recorded with.
+ *  for each bag it prints the largest error of pos, vel, acc and jrk over all the joints and loops (with the
+ *  time of the first loop above the tolerance), the loops whose setpoint differs from the recorded one (a
+ *  command given to another loop than in the recording) and the speed as simulated seconds per wall second.
+ *  a bag fails when an error is above its tolerance (default 1e-6, 1e-5, 1e-3, 1e-1), the exit code is 1 if
+ *  any bag fails, so -s / -i check a solver or a kernel against the recordings of the generated models.
+ *  reads the bags with the rosbag api, no ros master needed.
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include "rosbag/bag.h"
+#include "rosbag/view.h"
+#include "std_msgs/Float64MultiArray.h"
+#include "jerk_limited_controller.h"
+#include "waypoint_sequencer.h"
+#include "jogging_limits.h"
+
+const int n_jts = 6;   // the bags were recorded with the six joints nodes
+const int n_quantities = 4;
+const char *quantity_names[n_quantities] = {"pos", "vel", "acc", "jrk"};
+
+
+double now_sec(){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+enum replay_mode {
+    REPLAY_EACH_WAYPOINT = 0,
+    REPLAY_LAST_WAYPOINT,
+    REPLAY_VELOCITY,
+    N_REPLAY_MODES
+};
+
+// limits and gains, and the clamp of /cmd_vel of the velocity node
+enum { SM = 0, VM, AM, JM, KP, KV, KA, CMD_VEL_MAX, n_params };
+const char *param_names[n_params] = {"sm", "vm", "am", "jm", "kp", "kv", "ka", "cmd_vel_max"};
+
+// topics, limits and gains of the nodes (each_waypoint_controller.cpp, last_waypoint_controller.cpp,
+// velocity_jogging_controller.cpp)
+struct node_config {
+    const char *name;
+    const char *state_topic;
+    const char *cmd_topic;
+    double prm[n_params];
+};
+
+const node_config nodes[N_REPLAY_MODES] = {
+    {"each waypoint", "/state_each_waypts", "/cmd_pos", {180, 130, 250,  985, 1200, 400, 20,   0}},
+    {"last waypoint", "/state_last_waypts", "/cmd_pos", {180, 130, 250,  500, 1200, 400, 20,   0}},
+    {"velocity",      "/out_state",         "/cmd_vel", {180, 130, 250, 1000,    0,  20,  8, 180}}
+};
+const double cnt = 1e-2;
+const double cmd_margin = 0.3e-3;   // [s] a command received later was too late for the loop of that state
+
+// a bag and its settings, NAN where the node value is used
+struct bag_case {
+    std::string file;
+    double prm[n_params];
+};
+
+// "name=value" into the settings, false if the name is unknown
+bool parse_setting(const char *str, double *prm){
+    const char *eq = strchr(str, '=');
+    if (!eq)
+        return false;
+    for (int i=0; i<n_params; i++)
+        if (strlen(param_names[i]) == (size_t)(eq - str) && strncmp(str, param_names[i], eq - str) == 0) {
+            prm[i] = atof(eq + 1);
+            return true;
+        }
+    return false;
+}
+
+// bags of a list file, each one with the settings of the command line and then its own
+bool read_bag_list(const char *list_file, const double *prm, std::vector<bag_case> &cases){
+    std::ifstream in(list_file);
+    if (!in)
+        return false;
+    std::string dir(list_file);
+    dir = dir.find('/') == std::string::npos ? "" : dir.substr(0, dir.rfind('/') + 1);
+    std::string line;
+    int line_no = 0;
+    while (std::getline(in, line)) {
+        line_no++;
+        std::istringstream ss(line.substr(0, line.find('#')));
+        std::string word;
+        if (!(ss >> word))
+            continue;
+        bag_case c;
+        c.file = word[0] == '/' ? word : dir + word;
+        memcpy(c.prm, prm, sizeof(c.prm));
+        while (ss >> word)
+            if (!parse_setting(word.c_str(), c.prm))
+                fprintf(stderr, "%s:%d: unknown setting %s, ignored\n", list_file, line_no, word.c_str());
+        cases.push_back(c);
+    }
+    return true;
+}
+
+
+// commands and states of a bag, the commands with the loop they are given to
+struct recording {
+    replay_mode mode;
+    std::vector<double> cmds;         // n_jts values per command
+    std::vector<int> cmd_loops;       // loop of each command
+    std::vector<double> states;       // n_jts*5 values per loop: pos, vel, acc, jrk of each joint, then setpoints
+    std::vector<double> state_times;  // [s] from the first state
+};
+
+// false (and a message) if the bag can not be read or has no commands or states of a controller
+bool read_recording(const char *file, recording &rec){
+    struct timed_cmd { double t; std::string topic; std::vector<double> v; };
+    std::vector<timed_cmd> cmds;
+    std::vector<double> times;
+    int mode = -1;
+    try {
+        rosbag::Bag bag(file, rosbag::bagmode::Read);
+        rosbag::View view(bag);
+        for (rosbag::View::iterator it=view.begin(); it!=view.end(); ++it) {
+            const std::string &topic = it->getTopic();
+            std_msgs::Float64MultiArray::ConstPtr msg = it->instantiate<std_msgs::Float64MultiArray>();
+            if (!msg)
+                continue;
+            for (int m=0; m<N_REPLAY_MODES; m++)
+                if (topic == nodes[m].state_topic && msg->data.size() >= (size_t)n_jts*5) {
+                    if (mode >= 0 && mode != m) {
+                        fprintf(stderr, "%s: states of two controllers, skipped\n", file);
+                        return false;
+                    }
+                    mode = m;
+                    rec.states.insert(rec.states.end(), msg->data.begin(), msg->data.begin() + n_jts*5);
+                    times.push_back(it->getTime().toSec());
+                }
+            if ((topic == "/cmd_pos" || topic == "/cmd_vel") && msg->data.size() >= (size_t)n_jts) {
+                timed_cmd c;
+                c.t = it->getTime().toSec();
+                c.topic = topic;
+                c.v.assign(msg->data.begin(), msg->data.begin() + n_jts);
+                cmds.push_back(c);
+            }
+        }
+        bag.close();
+    }
+    catch (const rosbag::BagException &e) {
+        fprintf(stderr, "%s: %s\n", file, e.what());
+        return false;
+    }
+    if (mode < 0) {
+        fprintf(stderr, "%s: no controller states, skipped\n", file);
+        return false;
+    }
+    rec.mode = (replay_mode)mode;
+
+    // a command is taken by the first loop that publishes after it
+    size_t k = 0;
+    for (size_t c=0; c<cmds.size(); c++) {
+        if (cmds[c].topic != nodes[mode].cmd_topic)
+            continue;
+        while (k < times.size() && times[k] < cmds[c].t + cmd_margin)
+            k++;
+        rec.cmds.insert(rec.cmds.end(), cmds[c].v.begin(), cmds[c].v.end());
+        rec.cmd_loops.push_back((int)k);
+    }
+    if (rec.cmd_loops.empty()) {
+        fprintf(stderr, "%s: no %s, skipped\n", file, nodes[mode].cmd_topic);
+        return false;
+    }
+    rec.state_times.resize(times.size());
+    for (size_t i=0; i<times.size(); i++)
+        rec.state_times[i] = times[i] - times[0];
+    return true;
+}
+
+
+struct replay_result {
+    double max_err[n_quantities];
+    double max_err_time[n_quantities];
+    double first_fail_time[n_quantities];   // -1: within the tolerance
+    int setpoint_mismatches;
+    double first_mismatch_time;
+    double wall;
+};
+
+// runs the loops of the node with the commands of the recording and the limits and gains prm, outputs of
+// every loop into out (n_jts*5 values per loop, the layout of the states), returns the wall time of the loops
+double replay(const recording &rec, const double *prm, jlc_solver solver, jlc_isa isa, double frq,
+              std::vector<double> &out){
+    const int n_loops = (int)rec.state_times.size();
+    const int n_cmds = (int)rec.cmd_loops.size();
+    out.assign((size_t)n_loops*n_jts*5, 0.0);
+
+    JerkLimitedController<n_jts> controller;
+    controller.initialize();
+    controller.set_limits(prm[SM], prm[VM], prm[AM], prm[JM]);
+    controller.set_gains(prm[KP], prm[KV], prm[KA]);
+    controller.set_solver(solver);
+    controller.set_isa(isa);
+    controller.set_step_size(1.0/frq);
+    WaypointSequencer<n_jts> seq(cnt, n_cmds + 1);
+    const double zero[n_jts] = {0};
+    seq.push(zero);
+    JoggingLimits<n_jts> limits(prm[SM]);
+    const double *last_cmd = NULL;
+    double cmd_vel[n_jts] = {0};
+
+    JerkLimitedController<n_jts>::inputs &ctrl_U = controller.input();
+    const JerkLimitedController<n_jts>::outputs &ctrl_Y = controller.output();
+    const double t0 = now_sec();
+    int c = 0;
+    for (int k=0; k<n_loops; k++) {
+        for (; c < n_cmds && rec.cmd_loops[c] <= k; c++) {
+            last_cmd = &rec.cmds[(size_t)c*n_jts];
+            if (rec.mode == REPLAY_EACH_WAYPOINT)
+                seq.push(last_cmd);
+            if (rec.mode == REPLAY_VELOCITY)   // clamped by the callback of the node
+                for (int jt=0; jt<n_jts; jt++)
+                    cmd_vel[jt] = fmax(-prm[CMD_VEL_MAX], fmin(prm[CMD_VEL_MAX], last_cmd[jt]));
+        }
+        // the states of a bag start with the first command, a loop before it would not publish
+        const double *setpoint;
+        switch (rec.mode) {
+        case REPLAY_EACH_WAYPOINT:
+            setpoint = seq.update(ctrl_Y.POS);
+            memcpy(ctrl_U.pos, setpoint, sizeof(ctrl_U.pos));
+            break;
+        case REPLAY_LAST_WAYPOINT:
+            setpoint = last_cmd ? last_cmd : zero;
+            memcpy(ctrl_U.pos, setpoint, sizeof(ctrl_U.pos));
+            break;
+        default:
+            limits.apply(cmd_vel, ctrl_U.vel);
+            setpoint = ctrl_U.vel;
+            break;
+        }
+        controller.step();
+        if (rec.mode == REPLAY_VELOCITY)
+            limits.update(ctrl_Y.POS, ctrl_Y.VEL);
+
+        double *state = &out[(size_t)k*n_jts*5];
+        for (int jt=0; jt<n_jts; jt++) {
+            state[4*jt]     = ctrl_Y.POS[jt];
+            state[4*jt + 1] = ctrl_Y.VEL[jt];
+            state[4*jt + 2] = ctrl_Y.ACC[jt];
+            state[4*jt + 3] = ctrl_Y.JRK[jt];
+            state[4*n_jts + jt] = setpoint[jt];
+        }
+    }
+    return now_sec() - t0;
+}
+
+// errors of the replayed states against the recorded ones
+void compare(const recording &rec, const std::vector<double> &out, const double *tol, replay_result &res){
+    for (int q=0; q<n_quantities; q++) {
+        res.max_err[q] = 0;
+        res.max_err_time[q] = 0;
+        res.first_fail_time[q] = -1;
+    }
+    res.setpoint_mismatches = 0;
+    res.first_mismatch_time = -1;
+    for (size_t k=0; k<rec.state_times.size(); k++) {
+        const double *sim = &out[k*n_jts*5];
+        const double *ref = &rec.states[k*n_jts*5];
+        const double t = rec.state_times[k];
+        for (int jt=0; jt<n_jts; jt++)
+            for (int q=0; q<n_quantities; q++) {
+                const double err = fabs(sim[4*jt + q] - ref[4*jt + q]);
+                if (err > res.max_err[q]) {
+                    res.max_err[q] = err;
+                    res.max_err_time[q] = t;
+                }
+                if (err > tol[q] && res.first_fail_time[q] < 0)
+                    res.first_fail_time[q] = t;
+            }
+        bool mismatch = false;
+        for (int jt=0; jt<n_jts; jt++)
+            if (sim[4*n_jts + jt] != ref[4*n_jts + jt])
+                mismatch = true;
+        if (mismatch && !res.setpoint_mismatches++)
+            res.first_mismatch_time = t;
+    }
+}
+
+
+int main(int argc, char **argv)
+{
+    const char *usage = "usage: %s [-s solver=ode3] [-i isa=best] [-r rate=125] [-t pos,vel,acc,jrk] [-p name=value]"
+                        " (-m list_file | <bag> [bag ...])\n";
+    jlc_solver solver = JLC_SOLVER_ODE3;
+    jlc_isa isa = jlc_best_isa();
+    double frq = 125;
+    double tol[n_quantities] = {1e-6, 1e-5, 1e-3, 1e-1};
+    double prm[n_params];
+    for (int i=0; i<n_params; i++)
+        prm[i] = NAN;
+    const char *list_file = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "s:i:r:t:p:m:")) != -1) {
+        switch (opt) {
+        case 's':
+            if (!jlc_solver_from_name(optarg, solver)) {
+                fprintf(stderr, "unknown solver %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 'i': {
+            int i = JLC_ISA_SCALAR;
+            while (i <= JLC_ISA_AVX512 && strcmp(optarg, jlc_isa_name((jlc_isa)i)) != 0)
+                i++;
+            if (i > jlc_best_isa()) {
+                fprintf(stderr, "unknown or unsupported instruction set %s (best: %s)\n", optarg,
+                        jlc_isa_name(jlc_best_isa()));
+                return 1;
+            }
+            isa = (jlc_isa)i;
+            break;
+        }
+        case 'r':
+            frq = atof(optarg);
+            if (!(frq > 0)) {
+                fprintf(stderr, "rate has to be positive\n");
+                return 1;
+            }
+            break;
+        case 't':
+            if (sscanf(optarg, "%lf,%lf,%lf,%lf", &tol[0], &tol[1], &tol[2], &tol[3]) != n_quantities) {
+                fprintf(stderr, "-t takes the four tolerances pos,vel,acc,jrk\n");
+                return 1;
+            }
+            break;
+        case 'p':
+            if (!parse_setting(optarg, prm)) {
+                fprintf(stderr, "-p takes sm, vm, am, jm, kp, kv, ka or cmd_vel_max=value\n");
+                return 1;
+            }
+            break;
+        case 'm':
+            list_file = optarg;
+            break;
+        default:
+            fprintf(stderr, usage, argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<bag_case> cases;
+    if (list_file && !read_bag_list(list_file, prm, cases)) {
+        fprintf(stderr, "can not open %s\n", list_file);
+        return 1;
+    }
+    for (int b=optind; b<argc; b++) {
+        bag_case c;
+        c.file = argv[b];
+        memcpy(c.prm, prm, sizeof(c.prm));
+        cases.push_back(c);
+    }
+    if (cases.empty()) {
+        fprintf(stderr, usage, argv[0]);
+        return 1;
+    }
+
+    printf("solver: %s, kernel: %s, rate: %g Hz, tolerances: pos %g vel %g acc %g jrk %g\n\n",
+           jlc_solver_name(solver), jlc_isa_name(isa), frq, tol[0], tol[1], tol[2], tol[3]);
+    int n_failed = 0, n_skipped = 0;
+    double total_sim = 0, total_wall = 0;
+    std::vector<double> out;
+    for (size_t b=0; b<cases.size(); b++) {
+        const char *file = cases[b].file.c_str();
+        recording rec;
+        if (!read_recording(file, rec)) {
+            n_skipped++;
+            continue;
+        }
+        // settings of the bag over the ones of its node
+        double bag_prm[n_params];
+        std::string settings;
+        for (int i=0; i<n_params; i++) {
+            bag_prm[i] = std::isnan(cases[b].prm[i]) ? nodes[rec.mode].prm[i] : cases[b].prm[i];
+            if (!std::isnan(cases[b].prm[i])) {
+                char str[48];
+                snprintf(str, sizeof(str), " %s=%g", param_names[i], bag_prm[i]);
+                settings += str;
+            }
+        }
+        const int n_loops = (int)rec.state_times.size();
+        replay_result res;
+        res.wall = replay(rec, bag_prm, solver, isa, frq, out);
+        compare(rec, out, tol, res);
+
+        bool failed = false;
+        for (int q=0; q<n_quantities; q++)
+            failed = failed || res.first_fail_time[q] >= 0;
+        n_failed += failed;
+        const double sim = n_loops/frq;
+        total_sim += sim;
+        total_wall += res.wall;
+
+        printf("%s: %s%s, %d commands, %d loops (%.2f s)  %s\n", file, nodes[rec.mode].name, settings.c_str(),
+               (int)rec.cmd_loops.size(), n_loops, sim, failed ? "FAILED" : "ok");
+        for (int q=0; q<n_quantities; q++) {
+            printf("    max |%s error| %10.3g at t=%7.3f s", quantity_names[q], res.max_err[q], res.max_err_time[q]);
+            if (res.first_fail_time[q] >= 0)
+                printf("   above %g from t=%.3f s", tol[q], res.first_fail_time[q]);
+            printf("\n");
+        }
+        if (res.setpoint_mismatches)
+            printf("    setpoint differs in %d loops, from t=%.3f s\n", res.setpoint_mismatches, res.first_mismatch_time);
+        printf("    replay %.3f ms, %.0f simulated s per wall s\n", 1e3*res.wall, res.wall > 0 ? sim/res.wall : 0.0);
+    }
+    printf("\n%d bags, %d failed, %d skipped, %.0f simulated s per wall s\n", (int)cases.size() - n_skipped, n_failed,
+           n_skipped, total_wall > 0 ? total_sim/total_wall : 0.0);
+    return n_failed ? 1 : 0;
+}
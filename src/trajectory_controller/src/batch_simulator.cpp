@@ -0,0 +1,171 @@
+/**
+\file   batch_simulator.cpp
+\brief  offline run of controller_approaching_each_waypoint on a waypoint file, as fast as the cpu allows.
+ *
+ *  usage: batch_simulator <waypoints_file> [out_file|-] [rate=125] [substeps=1] [solver=ode3] [max_time=300]
+ *                         [blend_radius=0]
+ *  waypoints_file: one waypoint per line, N_JOINTS positions separated by spaces or commas, '#' starts a comment.
+ *  the same limits, gains, cnt and waypoint sequencing (waypoint_sequencer.h) as the node are used, the run
+ *  stops when the last waypoint is reached or after max_time seconds of simulated time.
+ *  blend_radius > cnt: the blending of the node's ~blend_radius, the intermediate waypoints are passed
+ *  within about blend_radius (WaypointSequencer::set_blend_radius), compare the simulated time with 0.
+ *  the outputs of all the steps are written by step_n() into one buffer allocated before the run,
+ *  out_file gets them as text: time, then pos vel acc jrk of joint_0, joint_1 .. and the setpoints.
+ *  no ros needed.
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include "jerk_limited_controller.h"
+#include "waypoint_sequencer.h"
+
+const double sm=180,  vm=130,  am=250, jm=985,  cnt= 1e-2, default_frq=125;
+
+#ifndef N_JOINTS
+#define N_JOINTS 6
+#endif
+const int n_jts = N_JOINTS;
+
+
+double now_sec(){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+typedef WaypointSequencer<n_jts>::waypoint waypoint;
+
+// reads the waypoints of the file, false if it can not be opened
+bool read_waypoints(const char *file, std::vector<waypoint> &wpts){
+    std::ifstream in(file);
+    if (!in)
+        return false;
+    std::string line;
+    int line_no = 0;
+    while (std::getline(in, line)) {
+        line_no++;
+        line = line.substr(0, line.find('#'));
+        for (size_t c=0; c<line.size(); c++)
+            if (line[c] == ',')
+                line[c] = ' ';
+        std::istringstream ss(line);
+        std::vector<double> wpt;
+        double x;
+        while (ss >> x)
+            wpt.push_back(x);
+        if (wpt.empty())
+            continue;
+        if ((int)wpt.size() < n_jts) {
+            fprintf(stderr, "%s:%d: %d values, expected %d joints, line skipped\n", file, line_no, (int)wpt.size(), n_jts);
+            continue;
+        }
+        waypoint w;
+        for (int jt=0; jt<n_jts; jt++)
+            w.pos[jt] = wpt[jt];
+        wpts.push_back(w);
+    }
+    return true;
+}
+
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <waypoints_file> [out_file|-] [rate=125] [substeps=1] [solver=ode3] [max_time=300]"
+                " [blend_radius=0]\n", argv[0]);
+        return 1;
+    }
+    const char *out_file  = argc > 2 ? argv[2] : "-";
+    const double frq      = argc > 3 ? atof(argv[3]) : default_frq;
+    const int substeps    = argc > 4 ? atoi(argv[4]) : 1;
+    const char *solver_nm = argc > 5 ? argv[5] : "ode3";
+    const double max_time = argc > 6 ? atof(argv[6]) : 300;
+    const double blend_radius = argc > 7 ? atof(argv[7]) : 0;
+    jlc_solver solver;
+    if (!(frq > 0) || substeps < 1 || !(max_time > 0)) {
+        fprintf(stderr, "rate and max_time have to be positive, substeps at least 1\n");
+        return 1;
+    }
+    if (!jlc_solver_from_name(solver_nm, solver)) {
+        fprintf(stderr, "unknown solver %s\n", solver_nm);
+        return 1;
+    }
+
+    std::vector<waypoint> wpts;
+    if (!read_waypoints(argv[1], wpts)) {
+        fprintf(stderr, "can not open %s\n", argv[1]);
+        return 1;
+    }
+    const int n_wpts = (int)wpts.size();
+    WaypointSequencer<n_jts> seq(cnt, wpts.size());
+    seq.set_blend_radius(blend_radius);
+    for (size_t k=0; k<wpts.size(); k++)
+        seq.push(wpts[k].pos);
+
+    JerkLimitedController<n_jts> controller;
+    controller.initialize();
+    controller.set_limits(sm, vm, am, jm);
+    controller.set_gains(1200, 400, 20);
+    controller.set_solver(solver);
+    controller.set_step_size(1.0/(frq*substeps));
+
+    // all the outputs (4 per joint and step) and the setpoints of every loop, allocated before the run
+    const int stride = 4*n_jts;
+    const long max_loops = (long)ceil(max_time*frq);
+    std::vector<double> out((size_t)max_loops*substeps*stride);
+    std::vector<double> setpoints((size_t)max_loops*n_jts);
+
+    const double t0 = now_sec();
+    long n_loops = 0;
+    const JerkLimitedController<n_jts>::outputs &ctrl_Y = controller.output();
+    while (n_loops < max_loops && !seq.finished(ctrl_Y.POS)) {
+        // same as one loop of the node: next waypoint if the current one is reached, then substeps steps
+        const double *wpt = seq.update(ctrl_Y.POS, ctrl_Y.VEL);
+        for (int jt=0; jt<n_jts; jt++) {
+            controller.input().pos[jt] = wpt[jt];
+            setpoints[(size_t)n_loops*n_jts + jt] = wpt[jt];
+        }
+        controller.step_n(substeps, &out[(size_t)n_loops*substeps*stride]);
+        n_loops++;
+    }
+    const double wall = now_sec() - t0;
+    const long n_steps = n_loops*substeps;
+
+    printf("waypoints: %d, joints: %d, rate: %g Hz x %d substeps, solver: %s, blend radius: %g\n",
+           n_wpts, n_jts, frq, substeps, jlc_solver_name(solver), seq.blend_radius());
+    printf("simulated %.3f s in %ld steps, wall time %.3f ms (x%.0f real time)\n",
+           controller.time(), n_steps, 1e3*wall, wall > 0 ? controller.time()/wall : 0.0);
+    if (!seq.finished(ctrl_Y.POS))
+        printf("max_time reached before the last waypoint (%d waypoints left)\n", (int)seq.n_pending());
+
+    if (strcmp(out_file, "-") != 0) {
+        FILE *f = fopen(out_file, "w");
+        if (!f) {
+            fprintf(stderr, "can not open %s\n", out_file);
+            return 1;
+        }
+        fprintf(f, "# time");
+        for (int jt=0; jt<n_jts; jt++)
+            fprintf(f, " pos_%d vel_%d acc_%d jrk_%d", jt, jt, jt, jt);
+        for (int jt=0; jt<n_jts; jt++)
+            fprintf(f, " setpoint_%d", jt);
+        fprintf(f, "\n");
+        for (long k=0; k<n_steps; k++) {
+            fprintf(f, "%.6f", (k + 1)*controller.step_size());
+            for (int i=0; i<stride; i++)
+                fprintf(f, " %.9g", out[(size_t)k*stride + i]);
+            for (int jt=0; jt<n_jts; jt++)
+                fprintf(f, " %.9g", setpoints[(size_t)(k/substeps)*n_jts + jt]);
+            fprintf(f, "\n");
+        }
+        fclose(f);
+    }
+    return 0;
+}
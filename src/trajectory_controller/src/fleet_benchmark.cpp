@@ -0,0 +1,91 @@
+/**
+\file   fleet_benchmark.cpp
+\brief  steps per second of JerkLimitedFleet from one thread up to all the cores.
+ *
+ *  usage: fleet_benchmark [n_instances=1000] [n_joints=6] [n_steps=1250]
+ *  every instance gets a different waypoint, the fleet is stepped n_steps (10 s at 125 Hz by default)
+ *  with 1, 2, ... hardware_concurrency threads, for each run it prints instance-steps per second and the
+ *  speedup against one thread. the first line is the same fleet as separate JerkLimitedController<6> objects.
+ *  no ros needed.
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <chrono>
+#include "jlc_fleet.h"
+#include "jerk_limited_controller.h"
+
+const double sm=180,  vm=130,  am=250, jm=985;
+
+
+double now_sec(){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double waypoint(int inst, int jt){
+    return 0.5*(inst % 17) - 4.0 + 0.3*jt;
+}
+
+void setup(JerkLimitedFleet &fleet){
+    fleet.set_limits(sm, vm, am, jm);
+    fleet.set_gains(1200, 400, 20);
+    fleet.initialize();
+    for (int inst=0; inst<fleet.n_instances(); inst++)
+        for (int jt=0; jt<fleet.n_joints(); jt++)
+            fleet.pos()[fleet.lane(inst, jt)] = waypoint(inst, jt);
+}
+
+
+int main(int argc, char **argv)
+{
+    const int n_inst  = argc > 1 ? atoi(argv[1]) : 1000;
+    const int n_jts   = argc > 2 ? atoi(argv[2]) : 6;
+    const int n_steps = argc > 3 ? atoi(argv[3]) : 1250;
+    const int n_cores = std::max(1u, std::thread::hardware_concurrency());
+
+    JerkLimitedFleet fleet(n_inst, n_jts);
+    printf("instances: %d, joints: %d, steps: %d, cores: %d, kernel: %s\n",
+           n_inst, n_jts, n_steps, n_cores, jlc_isa_name(fleet.isa()));
+
+    // baseline: one controller object per instance
+    if (n_jts == 6) {
+        std::vector< JerkLimitedController<6> > ctrl(n_inst);
+        for (int inst=0; inst<n_inst; inst++) {
+            ctrl[inst].set_limits(sm, vm, am, jm);
+            ctrl[inst].set_gains(1200, 400, 20);
+            ctrl[inst].initialize();
+            for (int jt=0; jt<6; jt++)
+                ctrl[inst].input().pos[jt] = waypoint(inst, jt);
+        }
+        const double t0 = now_sec();
+        for (int k=0; k<n_steps; k++)
+            for (int inst=0; inst<n_inst; inst++)
+                ctrl[inst].step();
+        const double dt = now_sec() - t0;
+        printf("separate objects  1 thread : %12.0f steps/s\n", n_inst*(double)n_steps/dt);
+    }
+
+    double base = 0;
+    for (int n_threads=1; n_threads<=n_cores; n_threads++) {
+        setup(fleet);
+        const double t0 = now_sec();
+        fleet.step(n_steps, n_threads);
+        const double dt = now_sec() - t0;
+        const double rate = n_inst*(double)n_steps/dt;
+        if (n_threads == 1)
+            base = rate;
+        printf("fleet   %3d thread(s)        : %12.0f steps/s   speedup %.2f\n", n_threads, rate, rate/base);
+    }
+
+    // checksum so the work is not optimized away and runs can be compared
+    double sum = 0;
+    for (int i=0; i<fleet.n_lanes(); i++)
+        sum += fleet.POS()[i];
+    printf("checksum: %.17g\n", sum);
+    return 0;
+}
@@ -9,10 +9,8 @@
 #include "ros/ros.h"
 #include "std_msgs/Float64MultiArray.h"
 #include "custom_msgs/state_msg.h"
-
-//#include "normal_toppra_traj_instant_3.h"
-#include "test_trajectory_1.h"
-//#include "test_trajectory_max_jrk.h"
+#include "ros/package.h"
+#include "trajectory_file.h"
 
 
 
@@ -20,12 +18,16 @@ int main(int argc, char **argv)
 {
     ros::init(argc, argv, "cmd_pos_publisher");
     ros::NodeHandle nh;
+    ros::NodeHandle pnh("~");
     ros::Publisher cmd_pos_pub = nh.advertise<std_msgs::Float64MultiArray>("cmd_pos", 1000);
     ros::Publisher state_pub = nh.advertise<custom_msgs::state_msg>("jug", 1000);
 
 
     //============ read trajectory ==========
-    trajectory_msgs::JointTrajectory  traj;
+    std::string traj_path;
+    pnh.param<std::string>("trajectory", traj_path,
+                           ros::package::getPath("trajectory_controller") + "/trajectories/test_trajectory_1.traj");
+    TrajectoryFile traj;
     custom_msgs::state_msg state_msg;
 
     for(int j=1; j<4; j++){
@@ -48,9 +50,12 @@ int main(int argc, char **argv)
 
 
 
-    traj = generate_traj();
-    int n_jts = traj.joint_names.size();
-    int n_pts = traj.points.size();
+    if (!traj.open(traj_path) || !traj.verify()) {
+        ROS_ERROR_STREAM("trajectory: " << traj.error());
+        return 1;
+    }
+    int n_jts = traj.n_joints();
+    int n_pts = traj.n_points();
     ROS_INFO_STREAM( "number of joints, and points: "<< n_jts << ", "<<n_pts );
     ros::Rate init_delay( 1);
     init_delay.sleep();
@@ -58,17 +63,11 @@ int main(int argc, char **argv)
     // variables
     std::vector< std::vector<double> > P_jt_wpt;
     P_jt_wpt.resize( n_jts);
-    for(int jt=0; jt<n_jts; jt++){
-        for(int pt=0; pt<n_pts; pt++){
-            P_jt_wpt[jt].push_back( traj.points[pt].positions[jt] );
-        }
-    }
+    for(int jt=0; jt<n_jts; jt++)
+        P_jt_wpt[jt].assign(traj.pos(jt), traj.pos(jt) + n_pts);
 
 
-    std::vector<double> T_wpt;
-    T_wpt.resize(n_pts);
-    for(int pt=0; pt<n_pts; pt++)
-        T_wpt[pt] = traj.points[pt].time_from_start.toSec()*1e-9 ;
+    std::vector<double> T_wpt(traj.time(), traj.time() + n_pts);
 
     // message for sending waypoints one by one
     std_msgs::Float64MultiArray msg;
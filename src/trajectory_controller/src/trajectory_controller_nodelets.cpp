@@ -0,0 +1,29 @@
+/**
+\file   trajectory_controller_nodelets.cpp
+\brief  nodelets of the position controllers and of the waypoint publisher (nodelet_plugins.xml).
+ *
+ *  trajectory_controller/EachWaypointNodelet:   controller_approaching_each_waypoint
+ *  trajectory_controller/LastWaypointNodelet:   controller_approaching_last_waypoint
+ *  trajectory_controller/CmdPosPublisherNodelet: cmd_pos_publisher
+ *  same topics and private parameters as the executables, e.g. launch/pipeline.launch
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#include "pluginlib/class_list_macros.h"
+#include "pipeline_nodelet.h"
+#include "each_waypoint_controller.h"
+#include "last_waypoint_controller.h"
+#include "cmd_pos_publisher.h"
+
+
+namespace trajectory_controller
+{
+typedef PipelineNodelet<EachWaypointController> EachWaypointNodelet;
+typedef PipelineNodelet<LastWaypointController> LastWaypointNodelet;
+typedef PipelineNodelet<CmdPosPublisher> CmdPosPublisherNodelet;
+}
+
+PLUGINLIB_EXPORT_CLASS(trajectory_controller::EachWaypointNodelet, nodelet::Nodelet)
+PLUGINLIB_EXPORT_CLASS(trajectory_controller::LastWaypointNodelet, nodelet::Nodelet)
+PLUGINLIB_EXPORT_CLASS(trajectory_controller::CmdPosPublisherNodelet, nodelet::Nodelet)
@@ -0,0 +1,86 @@
+/**
+\file   cmd_vel_publisher.cpp
+\brief  publishes a sequence of joint velocities, see cmd_vel_publisher.h
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#include "cmd_vel_publisher.h"
+#include "std_msgs/Float64MultiArray.h"
+#include <vector>
+
+
+CmdVelPublisher::CmdVelPublisher(const ros::NodeHandle &nh, const ros::NodeHandle &pnh): nh_(nh), running_(true){
+    cmd_vel_pub_ = nh_.advertise<std_msgs::Float64MultiArray>("cmd_vel", 100);
+}
+
+
+CmdVelPublisher::~CmdVelPublisher(){
+    stop();
+}
+
+
+bool CmdVelPublisher::start(){
+    running_ = true;
+    thread_ = std::thread(&CmdVelPublisher::run, this);
+    return true;
+}
+
+
+void CmdVelPublisher::stop(){
+    running_ = false;
+    if (thread_.joinable())
+        thread_.join();
+}
+
+
+bool CmdVelPublisher::sleep_for(double t){
+    const ros::Time end = ros::Time::now() + ros::Duration(t);
+    while (running_ && ros::ok()) {
+        const double left = (end - ros::Time::now()).toSec();
+        if (left <= 0)
+            return true;
+        ros::Duration(left < 0.1 ? left : 0.1).sleep();
+    }
+    return false;
+}
+
+
+void CmdVelPublisher::run(){
+    std::vector< std::vector<double> > vel_pt_jt={{-02,   35,  -25,  5,  30,    20},
+                                                  {-15,  -35,   -35,  0,  15,   -5},
+                                                  {-05,   00,   -25, -30,  35,   30},
+                                                  {  5,   00,   15, -20,  -25,   10}}; //different combinations
+
+
+//    std::vector< std::vector<double> > vel_pt_jt={{-02,  130,  130,  5,  30,    20},
+//                                                  {-15,  130,   130,  0,  15,   -5},
+//                                                  {-05,   130,   130, 0,  35,   30},
+//                                                  {  5,   00,   -130, -20,  -25,   10}}; //different combinations
+
+//    std::vector< std::vector<double> > vel_pt_jt={{-02,  130,  130,  5,  30,    20},
+//                                                  {-15,  -130,   130,  0,  15,   -5},
+//                                                  {-05,   130,   -130, 0,  35,   30},
+//                                                  {  5,   -130,   130, -20,  -25,   10}}; //different combinations
+
+
+
+    double t[]={1.35, 1.4, 5, 1.5}; //time bet. velocities changes
+    if (!sleep_for(1))
+        return;
+    for (unsigned long pt=0; pt<vel_pt_jt.size(); pt++)
+    {
+        // a new message for each command, the subscribers in the same process keep the pointer
+        std_msgs::Float64MultiArrayPtr msg(new std_msgs::Float64MultiArray);
+        for (int jt=0; jt<6; jt++)
+            msg->data.push_back( vel_pt_jt[pt][jt]);
+
+        cmd_vel_pub_.publish(msg);
+        double crnt_t = ros::Time::now().toSec();
+        if (!sleep_for(t[pt]))
+            return;
+        ROS_INFO_STREAM( "cmd_vel_"<< pt << ": "<< ros::Time::now().toSec() - crnt_t);
+        for (int jt=0; jt<6; jt++)
+            ROS_INFO_STREAM( "jt_"<< jt <<": "<<  vel_pt_jt[pt][jt]);
+    }
+}
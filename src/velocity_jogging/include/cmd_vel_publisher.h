@@ -0,0 +1,47 @@
+/**
+\file   cmd_vel_publisher.h
+\brief  publishes a sequence of joint velocities on "cmd_vel", used by cmd_vel_publisher and its nodelet.
+ *
+ *  4 different combinations of the velocities of the 6 joints, each one kept for its time, every command is a
+ *  new message published as a pointer, so the jogging controller loaded in the same nodelet manager gets it
+ *  without serialization.
+ *
+ *  usage:
+ *      executable:  CmdVelPublisher pub(nh, pnh);  pub.run();
+ *      nodelet:     pub.start();  ...  pub.stop();
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef CMD_VEL_PUBLISHER_H
+#define CMD_VEL_PUBLISHER_H
+
+#include <atomic>
+#include <thread>
+#include "ros/ros.h"
+
+
+class CmdVelPublisher
+{
+public:
+    CmdVelPublisher(const ros::NodeHandle &nh, const ros::NodeHandle &pnh);
+    ~CmdVelPublisher();
+
+    // sends the velocities, returns after the last one or after stop()
+    void run();
+    // run() in its own thread
+    bool start();
+    // ends run() within 0.1 s and waits for the thread
+    void stop();
+
+private:
+    // sleeps t seconds, false if stopped meanwhile
+    bool sleep_for(double t);
+
+    ros::NodeHandle nh_;
+    ros::Publisher cmd_vel_pub_;
+    std::atomic<bool> running_;
+    std::thread thread_;
+};
+
+#endif // CMD_VEL_PUBLISHER_H
@@ -0,0 +1,150 @@
+/**
+\file   compiled_scurve.h
+\brief  s_curve compiled to a table of cubics, sampled without recomputing the phases nor allocating.
+ *
+ *  sample_scurve() sums the segment times, builds their prefix sums, scans the segments, allocates four
+ *  vectors and replays the phases up to the sample (update_ip_time, update_ip_pos_vel_acc, phase_j1..j4)
+ *  at every call. here the 7 phases of every segment are turned once into cubics of the time since the start
+ *  of the phase:   p(tau) = c0 + c1 tau + c2 tau^2 + c3 tau^3   (c1: vel, 2 c2: acc, 6 c3: jerk at its start)
+ *  phases of zero duration are dropped. a sample is a binary search of the phase (or a cursor that follows
+ *  increasing times, O(1) when streaming at the control rate) and one Horner evaluation. the table is built
+ *  from the coefficients of one_dof_scurve_coef or segment by segment (the joints of n_dof_scurve_coef, one
+ *  table per joint). no ros dependency, allocates only when compiled.
+ *
+ *  usage:
+ *      CompiledScurve curve;
+ *      curve.compile(traj_T, jrk, seg_idx);            // from one_dof_scurve_coef
+ *      or: curve.clear();  for seg: curve.add_segment(Tj, Ta, Tv, jrk, p0);
+ *      curve.sample(tg, p, v, a, j);                   // any tg in [0, curve.duration()]
+ *      CompiledScurve::cursor c;  loop: curve.sample(tg, c, p, v, a, j);   // increasing tg
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef COMPILED_SCURVE_H
+#define COMPILED_SCURVE_H
+
+#include <stddef.h>
+#include <vector>
+#include <algorithm>
+
+
+class CompiledScurve
+{
+public:
+    // phase of the last sample, for samples at increasing times
+    struct cursor {
+        size_t phase;
+        cursor(): phase(0) {}
+    };
+
+    CompiledScurve() { clear(); }
+
+    void clear(){
+        t0_.assign(1, 0.0);
+        c_.clear();
+        p_end_ = 0;
+    }
+
+    // the coefficients of one_dof_scurve_coef: traj_T[0..3][seg] = Tj, Ta, Tv, T, jrk[seg], seg_idx[seg] the
+    // position at the start of seg
+    void compile(const std::vector< std::vector<double> > &traj_T, const std::vector<double> &jrk,
+                 const std::vector<double> &seg_idx){
+        clear();
+        reserve(jrk.size());
+        for (size_t seg=0; seg<jrk.size(); seg++)
+            add_segment(traj_T[0][seg], traj_T[1][seg], traj_T[2][seg], jrk[seg], seg_idx[seg]);
+    }
+
+    void reserve(size_t n_segs){
+        t0_.reserve(7*n_segs + 1);
+        c_.reserve(7*n_segs);
+    }
+
+    // appends a segment that starts at rest at p0: jerk jr for Tj, 0 for Ta, -jr for Tj, 0 for Tv, -jr for
+    // Tj, 0 for Ta, jr for Tj (the phases j1, a1, j2, v, j3, a2, j4 of s_curve_functions.cpp)
+    void add_segment(double Tj, double Ta, double Tv, double jr, double p0){
+        const double T[7] = {Tj, Ta, Tj, Tv, Tj, Ta, Tj};
+        const double J[7] = {jr, 0, -jr, 0, -jr, 0, jr};
+        double p = p0, v = 0, a = 0;
+        for (int ph=0; ph<7; ph++) {
+            const double tau = T[ph];
+            if (!(tau > 0))
+                continue;
+            const cubic c = {{p, v, a/2, J[ph]/6}};
+            c_.push_back(c);
+            t0_.push_back(t0_.back() + tau);
+            // state at the end of the phase
+            p = c.k[0] + tau*(c.k[1] + tau*(c.k[2] + tau*c.k[3]));
+            v = c.k[1] + tau*(2*c.k[2] + tau*3*c.k[3]);
+            a = 2*c.k[2] + tau*6*c.k[3];
+        }
+        p_end_ = p;
+    }
+
+    double duration() const { return t0_.back(); }
+    size_t n_phases() const { return c_.size(); }
+
+    // pos, vel, acc, jerk at tg, false if tg is outside [0, duration()]
+    bool sample(double tg, double &p, double &v, double &a, double &j) const {
+        if (!(tg >= 0 && tg <= duration()))
+            return false;
+        eval(find(tg), tg, p, v, a, j);
+        return true;
+    }
+
+    // the same from the phase of the previous sample: moves forward while tg is past the phase, back to a
+    // binary search if tg went back
+    bool sample(double tg, cursor &cur, double &p, double &v, double &a, double &j) const {
+        if (!(tg >= 0 && tg <= duration()))
+            return false;
+        eval(find(tg, cur), tg, p, v, a, j);
+        return true;
+    }
+
+    // the phase of tg in [0, duration()] (n_phases() > 0), its cubic coef(ph)[0..3] of tg - phase_start(ph),
+    // for the evaluation of many samples at once (scurve_batch.h)
+    size_t find(double tg) const {
+        const size_t ph = std::upper_bound(t0_.begin(), t0_.end() - 1, tg) - t0_.begin();
+        return ph > 0 ? ph-1 : 0;
+    }
+    size_t find(double tg, cursor &cur) const {
+        size_t ph = cur.phase;
+        if (ph >= c_.size() || tg < t0_[ph])
+            ph = find(tg);
+        else
+            while (ph+1 < c_.size() && t0_[ph+1] <= tg)
+                ph++;
+        cur.phase = ph;
+        return ph;
+    }
+    const double* coef(size_t ph) const { return c_[ph].k; }
+    double phase_start(size_t ph) const { return t0_[ph]; }
+    // position of a curve without phase (its segments do not move)
+    double rest_pos() const { return p_end_; }
+
+private:
+    struct cubic {
+        double k[4];
+    };
+
+    void eval(size_t ph, double tg, double &p, double &v, double &a, double &j) const {
+        if (c_.empty()) {
+            p = p_end_;
+            v = a = j = 0;
+            return;
+        }
+        const double *k = c_[ph].k;
+        const double tau = tg - t0_[ph];
+        p = k[0] + tau*(k[1] + tau*(k[2] + tau*k[3]));
+        v = k[1] + tau*(2*k[2] + tau*3*k[3]);
+        a = 2*k[2] + tau*6*k[3];
+        j = 6*k[3];
+    }
+
+    std::vector<double> t0_;   // start of every phase, then the end of the curve (n_phases()+1 values)
+    std::vector<cubic> c_;
+    double p_end_;             // position of a curve without phase
+};
+
+#endif // COMPILED_SCURVE_H
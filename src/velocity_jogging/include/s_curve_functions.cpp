@@ -4,16 +4,22 @@
  * 1. one_dof_scurve_coef: computes  the parameters of the s_curve for a certain path, it takes a reference time for the trajectory
  * if ref_T =0 then it calculates the optimal min time corresponding max jerk. returns coef required to reconstruct s_curve
  * 2. sample_scurve: it takes as input args the coed computed using one_dof_scurve and sampling time. it return the pos, vel, acc for each instant of time
+ * the same for several joints synchronized (each segment starts and ends at the same time for all the joints):
+ * 3. n_dof_scurve_coef: the time of each segment is the optimal time of its slowest joint, the other joints are slowed down to it
+ * 4. sample_n_dof_scurve: pos, vel, acc of all the joints at an instant of time
 */
 
 
 #include<math.h>
 #include <iostream>
 #include<vector>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+#include "dyn_limiter_funcs.h"   // cubic_eq_real_root, and the kernels of scurve_planning.h
 
 double min_root(double r1, double r2);
 double min_root(double r1, double r2,double r3);
-int  cubic_eq_real_root (double a, double b, double c, double d, std::vector<double> &roots);
 // equations that describe the motion in the seven phases of the s_curve
 void phase_j1 (double Tj, double Ta, double Tv, double P0, double V0, double A0, double jr, double t, double &a, double &v, double &p);
 void phase_a1 (double Tj, double Ta, double Tv, double P0, double V0, double A0, double jr, double t, double &a, double &v, double &p);
@@ -95,47 +101,17 @@ void update_ip_pos_vel_acc(std::vector<double> &P_jt_ipt, std::vector<double> &V
 //======================  compute_time_for_jrk: ======================
 //this func computes the trajectory time for specific jerk
 // it will be called at the begining with the max jerk as an argument to minimum optimal time for th etrajectory
+// (scurve_time_for_jerk, no print), throws std::invalid_argument for limits with am^2/jm > vm or a Ds not finite
 double compute_time_for_jrk(const double Ds, double &Tj, double &Ta, double &Tv, const double sm, const double vm, const double am, const double jm ){
-//    std::cout<< " ====== compute_time_for_jrk ============ "<< std::endl;
-
-    double Dthr1 = (am*vm)/jm + (vm*vm)/am ;
-    double Dthr2 = 2*pow(am,3)/pow(jm,2);
-    double Tjm= am/jm;
-    double Tam= (vm/am) - (am/jm);// how to get theis one
-
-    double D1 = (am/jm - vm/am)*(am*(am/jm - vm/am) - pow(am,2)/(2*jm)) + pow(am,3)/(2*pow(jm,2)) - (am*(am*(am/jm - vm/am) - pow(am,2)/jm))/jm - (am*(am*(am/jm - vm/am) - pow(am,2)/(2*jm)))/jm - (pow(am,2)*(am/jm - vm/am))/(2*jm);
-    // D1 from matlab using symbolic tool, till now it gives same results of
-
-//    std::cout<<" D1: "<< D1  <<std::endl;
-//    std::cout<<" Dthr1: "<< Dthr1 <<"   Dthr2: "<< Dthr2 <<std::endl;
-//    std::cout<<" Tjm: "<< Tjm <<"   Tam: "<< Tam <<std::endl;
-    if (Ds>= Dthr1){
-//        std::cout<<" compute_time_for_jrk case 1 ... "<<std::endl;
-        Tj= Tjm;
-        Ta= Tam;
-        Tv= (Ds-Dthr1)/vm;
-    }
-    else if(Ds>=Dthr2){
-//        std::cout<<" compute_time_for_jrk  case 2 ... "<<std::endl;
-        Tj= Tjm;
-//        Ta= sqrt( ((am*am)/(4*jm)) + (Ds/am) ) - ( (3*am)/(2*jm) );
-        Tv= 0;
-        double jr = jm;
-        double Ta1 = -(3*pow(Tj,2)*jr - sqrt(Tj*jr*(jr*pow(Tj,3) + 2*jr*pow(Tj,2)*Tv + jr*Tj*pow(Tv,2) + 4*Ds)) + Tj*Tv*jr)/(2*Tj*jr);
-        double Ta2 = -(3*pow(Tj,2)*jr + sqrt(Tj*jr*(jr*pow(Tj,3) + 2*jr*pow(Tj,2)*Tv + jr*Tj*pow(Tv,2) + 4*Ds)) + Tj*Tv*jr)/(2*Tj*jr);
-        std::cout<<" Ta1: "<< Ta1 <<"   Ta2: "<< Ta2 <<std::endl;
-        Ta = min_root(Ta1, Ta2);
-    }else {
-//        std::cout<<" compute_time_for_jrk case 3 ... "<<std::endl;
-        Tv=0;
-        Ta=0;
-        std::vector<double> rts;
-        rts.resize(3);
-        int sgn = (Ds>0)? 1:-1;
-        int n_rts = cubic_eq_real_root (2*sgn*jm, 0.0, 0.0, -Ds, rts);
-        Tj= rts[0];
-    }
-    return 4*Tj+2*Ta+Tv;
+    const scurve_limits lim = {sm, vm, am, jm};
+    scurve_phases ph;
+    const scurve_status st = scurve_time_for_jerk(Ds, lim, ph);
+    if (st != SCURVE_OK)
+        throw(std::invalid_argument(std::string("compute_time_for_jrk: ") + scurve_status_name(st)));
+    Tj= ph.Tj;
+    Ta= ph.Ta;
+    Tv= ph.Tv;
+    return ph.T;
 }
 
 
@@ -182,87 +158,44 @@ double compute_jerk_for_time( double &T, const double DT, const double Ds, doubl
 
 //============================== one_dof_scurve_coef ===========================
 /* the main function that will be called to compute the scurve coeffients for specific trajectory with specific max limits of Pos, Vel, Acc, Jrk
+ wrapper of scurve_plan_1dof (scurve_planning.h): a new segment starts where the direction of the path reverses,
+ waypoints on the way are passed without stopping. (it used to cut where the sign of the waypoints changed,
+ P_wpt[pt]*P_wpt[pt+1] < 0, so {0, 10, 5} was one segment that never went to 10)
  input argument:
     P_wpt: waypoints, ref_T: reference time for the trajectory, sm: max_Pos, vm: max_vel, am: max_acc, jm: max_jerk
  output_arg:
     jrk:  jrk per each segment in the path (whenever the direction changes we consider anew segment in the path)
     traj_T: vector of times of the inflection points for each segment in scurve the scurve
+    seg_idx: position at the start of each segment, and the last waypoint
+ throws std::invalid_argument if the waypoints or the limits are not valid, or ref_T > 0 is less than the optimal time
 */
-void one_dof_scurve_coef(  std::vector<double> P_wpt, double ref_T,  std::vector< std::vector<double> > &traj_T, std::vector<double> & jrk,
+void one_dof_scurve_coef(  const std::vector<double> &P_wpt, double ref_T,  std::vector< std::vector<double> > &traj_T, std::vector<double> & jrk,
                            std::vector<double> &seg_idx, double sm, double vm, double am, double jm){
-//    std::cout<< " ====== one_dof_scurve_coef ============ "<< std::endl;
-    int n_pts = P_wpt.size(); // number of waypoints
-//calculate n_traj per joint, when the direction is reversed, a new segment is considered
-    std::vector<double> trajs_idx;
-    trajs_idx.push_back(0);
-    int n_trajs=1;
-    for(int pt=0; pt<n_pts-1; pt++){
-        if( P_wpt[pt]*P_wpt[pt+1] < 0 ){
-            n_trajs++;
-            trajs_idx.push_back(pt);
-        }
-    }
-    trajs_idx.push_back(n_pts-1);
-    for(int seg=0; seg<trajs_idx.size() ; seg++)
-        seg_idx.push_back( P_wpt[trajs_idx[seg]] );
-
-//    std::cout<< "number of traj_segments (direction_change): "<< n_trajs << "  index wpts: " << std::endl;
-
-    // variables
-    traj_T[0].resize(n_trajs); // Tj
-    traj_T[1].resize(n_trajs); // Ta
-    traj_T[2].resize(n_trajs); // Tv
-    traj_T[3].resize(n_trajs); // T
-    jrk.resize(n_trajs); // Jrk
-
-    std::vector<double>  Ds;
-    std::vector<int> Ds_sgn;
-    Ds.resize(n_trajs);
-    Ds_sgn.resize(n_trajs);
-
-// for each seg or change in dir
-    for (int trj=0; trj< n_trajs; trj++){
-        double p0 = P_wpt[ trajs_idx[trj] ];
-        double pf = P_wpt[ trajs_idx[trj+1] ];
-        Ds[trj]= pf - p0;
-        Ds_sgn[trj] = (Ds[trj] > 0) ? 1 : ((Ds[trj] < 0) ? -1 : 0);
-
-         if(fabs(Ds[trj])<=1e-5){
-             Ds[trj] = 0;
-             Ds_sgn[trj] = 0;
-             traj_T[0][trj]= 0;
-             traj_T[1][trj]= 0;
-             traj_T[2][trj]= 0;
-             traj_T[3][trj]= 0;
-             jrk[trj]= 0;
-//              std::cout<< "Ds["<< trj <<"] is zero ";
-             continue;
-         }
-//          std::cout<< "Ds["<< trj <<"]= " << Ds[trj];
-         double t = compute_time_for_jrk(fabs(Ds[trj]),traj_T[0][trj], traj_T[1][trj], traj_T[2][trj], sm, vm, am, jm );
-         traj_T[3][trj] = t;
-         jrk[trj] = Ds_sgn[trj]*jm;
-     }
-
-    if(ref_T > 0){
-        double T_opt = 0;
-        for (auto& t : traj_T[3]) //total optimal time for all phases (max_jek, max_vel, max_acc)
-            T_opt += t;
-        if( ref_T < T_opt)
-            throw(std::invalid_argument("reference time is less than optimal time"));
-        std::vector<double> DT;
-        DT.resize(n_trajs);
-        double  dt = ref_T - T_opt;
-//        std::cout<< "ref_T, T_opt: "<< ref_T << "  "<< T_opt <<std::endl;
-
-        for (int trj=0; trj< n_trajs; trj++){
-          DT[trj] = traj_T[3][trj]*dt / T_opt;
-//          std::cout<< "T, DT, Ds, Tj,Ta,Tv: "<< traj_T[3][trj]<<"  "<<  DT[trj]<<"  "<< Ds[trj]<<"  "<< traj_T[0][trj]<<"  "<< traj_T[1][trj]<<"  "<< traj_T[2][trj]<< std::endl;
-          jrk[trj]= Ds_sgn[trj]*compute_jerk_for_time( traj_T[3][trj],  DT[trj], fabs(Ds[trj]), traj_T[0][trj], traj_T[1][trj], traj_T[2][trj], sm, vm, am, jm );
-//          std::cout<< "new_jrk: "<< jrk[trj] << std::endl << std::endl ;
-        }
-
+    const scurve_limits lim = {sm, vm, am, jm};
+    std::vector<scurve_segment> segs(std::max<size_t>(P_wpt.size(), 1));   // at most one segment per waypoint
+    size_t n_segs = 0;
+    const scurve_status st = scurve_plan_1dof(scurve_span<const double>(P_wpt.data(), P_wpt.size()), ref_T, lim,
+                                              scurve_span<scurve_segment>(segs.data(), segs.size()), n_segs);
+    if (st == SCURVE_TIME_TOO_SHORT)
+        throw(std::invalid_argument("reference time is less than optimal time"));
+    if (st != SCURVE_OK)
+        throw(std::invalid_argument(std::string("one_dof_scurve_coef: ") + scurve_status_name(st)));
+
+    traj_T.resize(4);
+    for (int i=0; i<4; i++)
+        traj_T[i].resize(n_segs);
+    jrk.resize(n_segs);
+    seg_idx.resize(n_segs+1);
+    for (size_t seg=0; seg<n_segs; seg++) {
+        const scurve_phases &ph = segs[seg].ph;
+        traj_T[0][seg] = ph.Tj;
+        traj_T[1][seg] = ph.Ta;
+        traj_T[2][seg] = ph.Tv;
+        traj_T[3][seg] = ph.T;
+        jrk[seg] = ph.jrk;
+        seg_idx[seg] = segs[seg].p0;
     }
+    seg_idx[n_segs] = P_wpt.back();
 }
 
 
@@ -350,79 +283,225 @@ bool sample_scurve( double tg,  std::vector<std::vector<double>> &traj_T, std::v
 
 
 
-//======================  cubic_eq_real_root: ======================
-//to find the real root/roots of a cubic equation
-int  cubic_eq_real_root (double a, double b, double c, double d, std::vector<double> &roots)
-{
-        if (a == 0.000)
-        {
-            throw(std::invalid_argument("The coefficient of the cube of x is 0. Please use the utility for a SECOND degree quadratic. No further action taken."));
-            return 0;
-        } //End if a == 0
-
-        if (d == 0.000)
-        {
-            throw(std::invalid_argument("One root is 0. Now divide through by x and use the utility for a SECOND degree quadratic to solve the resulting equation for the other two roots. No further action taken."));
-            return 0;
-        } //End if d == 0
-//        std::cout<<"Eq info: "<<std::endl;
-//        std::cout<< a <<", "<< b <<", "<< c <<", "<< d <<std::endl;
-        b /= a;
-        c /= a;
-        d /= a;
-        double disc, q, r, dum1, s, t, term1, r13;
-        q = (3.0*c - (b*b))/9.0;
-        r = -(27.0*d) + b*(9.0*c - 2.0*(b*b));
-        r /= 54.0;
-        disc = q*q*q + r*r;
-        double root1 = 0; //The first root is always real.
-        term1 = (b/3.0);
-        if (disc > 1e-10) { // one root real, two are complex
-//            std::cout<<"disc > 0, disc= "<< disc <<std::endl;
-            s = r + sqrt(disc);
-            s = ((s < 0) ? -pow(-s, (1.0/3.0)) : pow(s, (1.0/3.0)));
-            t = r - sqrt(disc);
-            t = ((t < 0) ? -pow(-t, (1.0/3.0)) : pow(t, (1.0/3.0)));
-            double x1r= -term1 + s + t;
-            term1 += (s + t)/2.0;
-            double x3r = -term1,  x2r = -term1;
-            term1 = sqrt(3.0)*(-t + s)/2;
-            x2r = term1;
-            double x3i = -term1;
-            roots[0]= x1r;
-            roots[1] = -100.0;
-            roots[2]= -100.0;
-            return 1;
+//============================== n_dof_scurve_coef ===========================
+/* synchronized s_curve of several joints: every joint starts and stops each segment at the same instants.
+ the path is cut into segments at every waypoint where it changes direction in joint space (every joint rests
+ at these waypoints, like one_dof_scurve_coef does where its joint reverses), the waypoints in between are on
+ the straight line of their segment and passed on the way, so the commanded path is the polyline of the
+ waypoints. per segment:
+    - the optimal time of each joint (compute_time_for_jrk with its own limits), the longest one is the
+      bottleneck joint and the time of the segment
+    - all the joints use the phases (Tj, Ta, Tv) of the bottleneck joint with their jerk scaled by their
+      distance: the same profile, so all the joints switch phase together and the path is a straight line in
+      joint space. if that profile exceeds the limits of a joint (its limits differ from the bottleneck's),
+      the phases of the segment are stretched by a common factor until no joint exceeds them: the jerk scales
+      with 1/k^3, the peak acc with 1/k^2 and the peak vel with 1/k
+ T_opt is the sum of these times, a ref_T longer than T_opt is split over the segments in proportion of their
+ times, a shorter one is not reachable, the plan stays optimal (duration == T_opt).
+ input argument:
+    P_wpt: waypoints, n_jts positions each, ref_T: reference time (0: optimal), sm, vm, am, jm: limits per joint
+ output_arg:
+    plan: the segments, see n_dof_scurve, sampled by sample_n_dof_scurve
+ returns false with the reason in error (plan unchanged) if the waypoints or the limits are not valid
+*/
+struct n_dof_scurve {
+    int n_jts;
+    int n_segs;
+    double T_opt;                                   // duration at the optimal time
+    double duration;                                // duration of the plan, max(ref_T, T_opt)
+    std::vector<double> T;                          // duration of each segment, the same for all the joints
+    std::vector<double> t_start;                    // start of each segment, n_segs+1 values (last: duration)
+    std::vector<int> bottleneck;                    // joint with the longest optimal time in each segment
+    std::vector< std::vector<double> > p0;          // [seg][jt] position at the start of the segment
+    std::vector< std::vector<double> > Tj, Ta, Tv;  // [seg][jt] phase times, the same for all the joints
+    std::vector< std::vector<double> > jrk;         // [seg][jt] signed jerk (0: the joint rests)
+};
+
+bool n_dof_scurve_coef( const std::vector< std::vector<double> > &P_wpt, double ref_T, n_dof_scurve &plan,
+                        const std::vector<double> &sm, const std::vector<double> &vm,
+                        const std::vector<double> &am, const std::vector<double> &jm, std::string &error){
+    const int n_pts = P_wpt.size();
+    if (n_pts < 2) {
+        error = "needs two waypoints at least";
+        return false;
+    }
+    const int n_jts = P_wpt[0].size();
+    if (n_jts < 1 || (int)sm.size() != n_jts || (int)vm.size() != n_jts || (int)am.size() != n_jts
+        || (int)jm.size() != n_jts) {
+        error = "needs the limits of the " + std::to_string(n_jts) + " joints";
+        return false;
+    }
+    for (int jt=0; jt<n_jts; jt++)
+        if (!(vm[jt] > 0 && am[jt] > 0 && jm[jt] > 0 && am[jt]*am[jt] <= vm[jt]*jm[jt])) {
+            // compute_time_for_jrk needs am reachable before vm (am^2/jm <= vm)
+            error = "limits of joint " + std::to_string(jt) + " not positive or am^2/jm > vm";
+            return false;
+        }
+    for (int pt=0; pt<n_pts; pt++) {
+        if ((int)P_wpt[pt].size() != n_jts) {
+            error = "waypoint " + std::to_string(pt) + " has " + std::to_string(P_wpt[pt].size())
+                    + " positions, expected " + std::to_string(n_jts);
+            return false;
+        }
+        for (int jt=0; jt<n_jts; jt++)
+            if (!std::isfinite(P_wpt[pt][jt])) {
+                error = "waypoint " + std::to_string(pt) + " joint " + std::to_string(jt) + " not finite";
+                return false;
+            }
+    }
+
+    // segments: a segment goes on through a waypoint only if the next one is further along the same straight
+    // line of joint space (within 1e-5 of it), repeated waypoints are skipped
+    std::vector<int> wpt_idx;
+    wpt_idx.push_back(0);
+    std::vector<double> u(n_jts, 0);   // unit direction of the current segment, 0: not known yet
+    for (int pt=0; pt<n_pts-1; pt++) {
+        const std::vector<double> &s0 = P_wpt[ wpt_idx.back() ], &q = P_wpt[pt+1];
+        double len = 0;
+        for (int jt=0; jt<n_jts; jt++)
+            len += (q[jt] - P_wpt[pt][jt])*(q[jt] - P_wpt[pt][jt]);
+        if (sqrt(len) <= 1e-5)
+            continue;
+        const bool moving = std::any_of(u.begin(), u.end(), [](double x){ return x != 0; });
+        bool on_line = false;
+        if (moving) {
+            // forward along u, and q within 1e-5 of the line of the segment
+            double fwd = 0, along = 0, dist = 0;
+            for (int jt=0; jt<n_jts; jt++) {
+                fwd += (q[jt] - P_wpt[pt][jt])*u[jt];
+                along += (q[jt] - s0[jt])*u[jt];
+            }
+            for (int jt=0; jt<n_jts; jt++)
+                dist += (q[jt] - s0[jt] - along*u[jt])*(q[jt] - s0[jt] - along*u[jt]);
+            on_line = fwd > 0 && sqrt(dist) <= 1e-5;
+        }
+        if (!on_line) {
+            if (moving)
+                wpt_idx.push_back(pt);
+            const std::vector<double> &s1 = P_wpt[ wpt_idx.back() ];
+            double n = 0;
+            for (int jt=0; jt<n_jts; jt++)
+                n += (q[jt] - s1[jt])*(q[jt] - s1[jt]);
+            n = sqrt(n);
+            for (int jt=0; jt<n_jts; jt++)
+                u[jt] = (q[jt] - s1[jt])/n;
+        }
+    }
+    wpt_idx.push_back(n_pts-1);
+    const int n_segs = wpt_idx.size() - 1;
+
+    n_dof_scurve p;
+    p.n_jts = n_jts;
+    p.n_segs = n_segs;
+    p.T.assign(n_segs, 0);
+    p.t_start.assign(n_segs+1, 0);
+    p.bottleneck.assign(n_segs, 0);
+    p.p0.assign(n_segs, std::vector<double>(n_jts, 0));
+    p.Tj = p.Ta = p.Tv = p.jrk = p.p0;
+
+    // optimal time of each joint, the bottleneck sets the phases of the segment
+    std::vector< std::vector<double> > Ds(n_segs, std::vector<double>(n_jts, 0));
+    std::vector<double> tj(n_segs, 0), ta(n_segs, 0), tv(n_segs, 0);
+    p.T_opt = 0;
+    for (int seg=0; seg<n_segs; seg++) {
+        double T_b = 0;
+        for (int jt=0; jt<n_jts; jt++) {
+            p.p0[seg][jt] = P_wpt[ wpt_idx[seg] ][jt];
+            Ds[seg][jt] = P_wpt[ wpt_idx[seg+1] ][jt] - p.p0[seg][jt];
+            if (fabs(Ds[seg][jt]) <= 1e-5) {
+                Ds[seg][jt] = 0;
+                continue;
+            }
+            double Tj, Ta, Tv;
+            const double T = compute_time_for_jrk(fabs(Ds[seg][jt]), Tj, Ta, Tv, sm[jt], vm[jt], am[jt], jm[jt]);
+            if (T > T_b) {
+                T_b = T;
+                p.bottleneck[seg] = jt;
+                tj[seg] = Tj;
+                ta[seg] = Ta;
+                tv[seg] = Tv;
+            }
+        }
+        // the jerk of a profile with these phases scales with the distance, the distance at unit jerk is
+        // Tj (Tj+Ta) (2Tj+Ta+Tv). a joint with other limits than the bottleneck may exceed them, stretch the
+        // phases by the smallest common factor that keeps every joint inside (1e-9: rounding of the bottleneck)
+        const double D_unit = tj[seg]*(tj[seg]+ta[seg])*(2*tj[seg]+ta[seg]+tv[seg]);
+        double stretch = 1;
+        for (int jt=0; jt<n_jts && D_unit > 0; jt++) {
+            const double jr = fabs(Ds[seg][jt])/D_unit;
+            stretch = std::max(stretch, cbrt(jr/jm[jt]));
+            stretch = std::max(stretch, sqrt(jr*tj[seg]/am[jt]));
+            stretch = std::max(stretch, jr*tj[seg]*(tj[seg]+ta[seg])/vm[jt]);
+        }
+        if (stretch > 1 + 1e-9) {
+            tj[seg] *= stretch;
+            ta[seg] *= stretch;
+            tv[seg] *= stretch;
+        }
+        p.T[seg] = 4*tj[seg] + 2*ta[seg] + tv[seg];
+        p.T_opt += p.T[seg];
+    }
+
+    // a longer reference time stretches every segment by the same ratio, the jerk, acc and vel only decrease
+    const double k = (ref_T > p.T_opt && p.T_opt > 0) ? ref_T/p.T_opt : 1;
+    for (int seg=0; seg<n_segs; seg++) {
+        const double Tj = k*tj[seg], Ta = k*ta[seg], Tv = k*tv[seg];
+        const double D_unit = Tj*(Tj+Ta)*(2*Tj+Ta+Tv);
+        for (int jt=0; jt<n_jts; jt++) {
+            // a joint that rests keeps the phases too, for the sampling
+            p.Tj[seg][jt] = Tj;
+            p.Ta[seg][jt] = Ta;
+            p.Tv[seg][jt] = Tv;
+            p.jrk[seg][jt] = (Ds[seg][jt] != 0 && D_unit > 0) ? Ds[seg][jt]/D_unit : 0;
         }
-        // End if (disc > 0)
-        // The remaining options are all real
-        double x3i =0, x2r = 0;
-        if (disc>=0.000 && disc< 1e-10){ // All roots real, at least two are equal.
-//            std::cout<<"disc = 0 , disc= "<< disc <<std::endl;
-            disc=0;
-            r13 = ((r < 0) ? -pow(-r,(1.0/3.0)) : pow(r,(1.0/3.0)));
-            double x1r= -term1 + 2.0*r13;
-            double x3r = -(r13 + term1);
-            x2r = -(r13 + term1);
-            roots[0]= x1r;
-            roots[1] = x2r;
-            roots[2]= x3r;
-            return 2;
-        } // End if (disc == 0)
-        // Only option left is that all roots are real and unequal (to get here, q < 0)
-//        std::cout<<"disc < 0 , disc= "<< disc <<std::endl;
-        q = -q;
-        dum1 = q*q*q;
-        dum1 = acos(r/sqrt(dum1));
-        r13 = 2.0*sqrt(q);
-        double x1r= -term1 + r13*cos(dum1/3.0);
-        x2r = -term1 + r13*cos((dum1 + 2.0*M_PI)/3.0);
-        double x3r = -term1 + r13*cos((dum1 + 4.0*M_PI)/3.0);
-        roots[0]= x1r;
-        roots[1] = x2r;
-        roots[2]= x3r;
-        return 3;
-}  //End of cubicSolve
+        p.T[seg] = k*p.T[seg];
+        p.t_start[seg+1] = p.t_start[seg] + p.T[seg];
+    }
+    p.duration = p.t_start[n_segs];
+    plan = p;
+    return true;
+}
+
+
+//========================= sample_n_dof_scurve ==========================
+/* pos, vel, acc of every joint at the time tg of a plan of n_dof_scurve_coef, P, V, A have plan.n_jts values.
+   false if tg is outside [0, plan.duration]
+*/
+bool sample_n_dof_scurve( double tg, const n_dof_scurve &plan, std::vector<double> &P, std::vector<double> &V,
+                          std::vector<double> &A){
+    if (tg < 0 || tg > plan.duration)
+        return false;
+    // segment of tg: the last one starting at or before tg
+    int seg = std::upper_bound(plan.t_start.begin(), plan.t_start.begin() + plan.n_segs, tg)
+              - plan.t_start.begin() - 1;
+    seg = std::max(0, seg);
+    const double t = std::min(tg - plan.t_start[seg], plan.T[seg]);
+    for (int jt=0; jt<plan.n_jts; jt++) {
+        const double Tj = plan.Tj[seg][jt], Ta = plan.Ta[seg][jt], Tv = plan.Tv[seg][jt], jr = plan.jrk[seg][jt];
+        double p=0, v=0, a=0;
+        if (jr == 0)
+            ;
+        else if (t < Tj)
+            phase_j1 (Tj, Ta, Tv, 0, 0, 0, jr, t, a, v, p);
+        else if (t < Tj+Ta)
+            phase_a1 (Tj, Ta, Tv, 0, 0, 0, jr, t, a, v, p);
+        else if (t < 2*Tj+Ta)
+            phase_j2 (Tj, Ta, Tv, 0, 0, 0, jr, t, a, v, p);
+        else if (t < 2*Tj+Ta+Tv)
+            phase_v  (Tj, Ta, Tv, 0, 0, 0, jr, t, a, v, p);
+        else if (t < 3*Tj+Ta+Tv)
+            phase_j3 (Tj, Ta, Tv, 0, 0, 0, jr, t, a, v, p);
+        else if (t < 3*Tj+2*Ta+Tv)
+            phase_a2 (Tj, Ta, Tv, 0, 0, 0, jr, t, a, v, p);
+        else
+            phase_j4 (Tj, Ta, Tv, 0, 0, 0, jr, std::min(t, 4*Tj+2*Ta+Tv), a, v, p);
+        P[jt] = plan.p0[seg][jt] + p;
+        V[jt] = v;
+        A[jt] = a;
+    }
+    return true;
+}
+
 
 
 //======================  min_root: ======================
@@ -525,57 +604,7 @@ void phase_j4 (double Tj, double Ta, double Tv, double P0, double V0, double A0,
 
 
 
+// position where the joint stops braking with jm from (p0, v0 >= 0, a0), see scurve_stop_distance
 double compute_stop_distance(double a0, double v0, double p0, double am, double vm, double jm){
-
-    double t1=0, t2=0, a1=0, a2=0, p1=0, p2=0;
-    double v1=0, v2=0;
-
-    if( abs(v0) <= 0.001 && abs(a0) <=0.001){
-        p2=0;
-        return p2;
-    }
-
-//    if( v0>=0){
-        t2 = sqrt( pow(a0,2)/(2*pow(jm,2)) + (v0/jm));
-        t1 = t2 +(a0/jm);
-
-        a1= -jm*t1 +a0;
-        v1 = -jm*pow(t1,2)/2 +a0*t1+v0;
-        p1 = -jm*pow(t1,3)/6 + a0*pow(t1,2)/2 + v0*t1 +p0;
-
-        a2=  jm*t2 +a1;
-        v2 =  jm*pow(t2,2)/2 +a1*t2+v1;
-        p2 =  jm*pow(t2,3)/6 + a1*pow(t2,2)/2 + v1*t2 +p1;
-
-//        std::cout<< "t1= " << t1 ;
-//        std::cout<< "   ;  t2= " << t2 << std::endl;
-//    }
-//    else {
-//        v0 =-v0;
-//        a0 = abs(a0);
-//        double t = v0+a0;
-//        double t3= v0- a0;
-//        double t4= v0-a0;
-
-//        t1 = sqrt( pow(a0,2)/(2*pow(jm,2)) + (v0/jm));
-//        t2 = t1 +(a0/jm);
-
-//        a1=   jm*t1 +a0;
-//        v1 =  jm*pow(t1,2)/2 +a0*t1+v0;
-//        p1 =  jm*pow(t1,3)/6 + a0*pow(t1,2)/2 + v0*t1 +p0;
-
-//        a2=  -jm*t2 +a1;
-//        v2 = -jm*pow(t2,2)/2 +a1*t2+v1;
-//        p2 = -jm*pow(t2,3)/6 + a1*pow(t2,2)/2 + v1*t2 +p1;
-
-//        std::cout<< "t1= " << t1 ;
-//        std::cout<< "   ;  t2= " << t2 << std::endl;
-//}
-    return p2;
-
+    return scurve_stop_distance(a0, v0, p0, jm);
 }
-
-
-
-
-
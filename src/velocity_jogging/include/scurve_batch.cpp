@@ -0,0 +1,229 @@
+/**
+\file   scurve_batch.cpp
+\brief  dense sampling of compiled s_curves, see scurve_batch.h
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+// the avx512f functions could fuse the multiplies and adds of the cubics (FMA), which rounds differently from
+// CompiledScurve::sample, keep them separate
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize ("fp-contract=off")
+#endif
+
+#include "scurve_batch.h"
+#include <stdint.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SCURVE_X86 1
+#endif
+
+
+// samples [begin, end) of one joint
+struct batch_chunk {
+    const CompiledScurve *curve;
+    const double *t;
+    size_t begin, end;
+    double *p, *v, *a, *j;   // already offset to the joint
+};
+
+// the samples of a chunk from k on that are in the phase [ts, te) of cubic q, curve of duration T
+struct batch_run {
+    size_t k;
+    const double *q;
+    double ts, te, T;
+};
+
+
+static inline double clamp_time(double tg, double duration){
+    return tg < 0 ? 0 : (tg > duration ? duration : tg);
+}
+
+// no phase: the joint rests
+static void rest_chunk(const batch_chunk &c){
+    const double p0 = c.curve->rest_pos();
+    for (size_t k=c.begin; k<c.end; k++) {
+        if (c.p) c.p[k] = p0;
+        if (c.v) c.v[k] = 0;
+        if (c.a) c.a[k] = 0;
+        if (c.j) c.j[k] = 0;
+    }
+}
+
+// evaluates the samples from r.k on while they are in the phase, returns the first one that is not (or c.end),
+// the same operations as CompiledScurve::sample
+static size_t eval_scalar(const batch_chunk &c, const batch_run &r){
+    const double *q = r.q;
+    size_t k = r.k;
+    for (; k<c.end; k++) {
+        const double tg = clamp_time(c.t[k], r.T);
+        if (tg < r.ts || tg >= r.te)
+            break;
+        const double tau = tg - r.ts;
+        if (c.p) c.p[k] = q[0] + tau*(q[1] + tau*(q[2] + tau*q[3]));
+        if (c.v) c.v[k] = q[1] + tau*(2*q[2] + tau*3*q[3]);
+        if (c.a) c.a[k] = 2*q[2] + tau*6*q[3];
+        if (c.j) c.j[k] = 6*q[3];
+    }
+    return k;
+}
+
+
+#ifdef SCURVE_X86
+
+// ============================== AVX2 ==============================
+
+#define SCURVE_AVX2 __attribute__((target("avx2")))
+
+SCURVE_AVX2 static size_t eval_avx2(const batch_chunk &c, batch_run r){
+    const __m256d q0 = _mm256_set1_pd(r.q[0]), q1 = _mm256_set1_pd(r.q[1]);
+    const __m256d q2 = _mm256_set1_pd(r.q[2]), q3 = _mm256_set1_pd(r.q[3]);
+    const __m256d ts = _mm256_set1_pd(r.ts), te = _mm256_set1_pd(r.te), T = _mm256_set1_pd(r.T);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d two_q2 = _mm256_mul_pd(_mm256_set1_pd(2), q2), six_q3 = _mm256_mul_pd(_mm256_set1_pd(6), q3);
+    const __m256d three = _mm256_set1_pd(3), six = _mm256_set1_pd(6);
+    for (; r.k+4<=c.end; r.k+=4) {
+        const __m256d tg = _mm256_min_pd(_mm256_max_pd(_mm256_loadu_pd(c.t+r.k), zero), T);
+        if (_mm256_movemask_pd(_mm256_or_pd(_mm256_cmp_pd(tg, ts, _CMP_LT_OQ), _mm256_cmp_pd(tg, te, _CMP_GE_OQ))))
+            break;   // a sample out of the phase, the scalar code finds it
+        const __m256d tau = _mm256_sub_pd(tg, ts);
+        if (c.p)
+            _mm256_storeu_pd(c.p+r.k, _mm256_add_pd(q0, _mm256_mul_pd(tau, _mm256_add_pd(q1, _mm256_mul_pd(tau,
+                                      _mm256_add_pd(q2, _mm256_mul_pd(tau, q3)))))));
+        if (c.v)
+            _mm256_storeu_pd(c.v+r.k, _mm256_add_pd(q1, _mm256_mul_pd(tau, _mm256_add_pd(two_q2,
+                                      _mm256_mul_pd(_mm256_mul_pd(tau, three), q3)))));
+        if (c.a)
+            _mm256_storeu_pd(c.a+r.k, _mm256_add_pd(two_q2, _mm256_mul_pd(_mm256_mul_pd(tau, six), q3)));
+        if (c.j)
+            _mm256_storeu_pd(c.j+r.k, six_q3);
+    }
+    return eval_scalar(c, r);   // less than 4 samples left, or out of the phase
+}
+
+
+// ============================== AVX-512 ==============================
+
+#define SCURVE_AVX512 __attribute__((target("avx512f")))
+
+SCURVE_AVX512 static size_t eval_avx512(const batch_chunk &c, batch_run r){
+    const __m512d q0 = _mm512_set1_pd(r.q[0]), q1 = _mm512_set1_pd(r.q[1]);
+    const __m512d q2 = _mm512_set1_pd(r.q[2]), q3 = _mm512_set1_pd(r.q[3]);
+    const __m512d ts = _mm512_set1_pd(r.ts), te = _mm512_set1_pd(r.te), T = _mm512_set1_pd(r.T);
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d two_q2 = _mm512_mul_pd(_mm512_set1_pd(2), q2), six_q3 = _mm512_mul_pd(_mm512_set1_pd(6), q3);
+    const __m512d three = _mm512_set1_pd(3), six = _mm512_set1_pd(6);
+    for (; r.k+8<=c.end; r.k+=8) {
+        const __m512d tg = _mm512_min_pd(_mm512_max_pd(_mm512_loadu_pd(c.t+r.k), zero), T);
+        if (_mm512_cmp_pd_mask(tg, ts, _CMP_LT_OQ) | _mm512_cmp_pd_mask(tg, te, _CMP_GE_OQ))
+            break;   // a sample out of the phase, the scalar code finds it
+        const __m512d tau = _mm512_sub_pd(tg, ts);
+        if (c.p)
+            _mm512_storeu_pd(c.p+r.k, _mm512_add_pd(q0, _mm512_mul_pd(tau, _mm512_add_pd(q1, _mm512_mul_pd(tau,
+                                      _mm512_add_pd(q2, _mm512_mul_pd(tau, q3)))))));
+        if (c.v)
+            _mm512_storeu_pd(c.v+r.k, _mm512_add_pd(q1, _mm512_mul_pd(tau, _mm512_add_pd(two_q2,
+                                      _mm512_mul_pd(_mm512_mul_pd(tau, three), q3)))));
+        if (c.a)
+            _mm512_storeu_pd(c.a+r.k, _mm512_add_pd(two_q2, _mm512_mul_pd(_mm512_mul_pd(tau, six), q3)));
+        if (c.j)
+            _mm512_storeu_pd(c.j+r.k, six_q3);
+    }
+    return eval_scalar(c, r);   // less than 8 samples left, or out of the phase
+}
+
+#endif // SCURVE_X86
+
+
+// the chunk cut in runs of consecutive samples in the same phase (the whole phase for increasing times),
+// each run evaluated with the cubic of its phase
+static void sample_chunk(const batch_chunk &c, jlc_isa isa){
+    const CompiledScurve &s = *c.curve;
+    if (s.n_phases() == 0) {
+        rest_chunk(c);
+        return;
+    }
+    CompiledScurve::cursor cur;
+    batch_run r;
+    r.T = s.duration();
+    r.k = c.begin;
+    while (r.k < c.end) {
+        const size_t ph = s.find(clamp_time(c.t[r.k], r.T), cur);
+        r.q = s.coef(ph);
+        r.ts = s.phase_start(ph);
+        r.te = ph+1 < s.n_phases() ? s.phase_start(ph+1) : r.T + 1;   // the last phase ends at T included
+#ifdef SCURVE_X86
+        if (isa == JLC_ISA_AVX512)
+            r.k = eval_avx512(c, r);
+        else if (isa == JLC_ISA_AVX2)
+            r.k = eval_avx2(c, r);
+        else
+#endif
+            r.k = eval_scalar(c, r);
+    }
+}
+
+
+void scurve_batch_sample(const CompiledScurve *curves, int n_jts, const double *t, const scurve_samples &out,
+                         int n_threads, size_t chunk_size){
+    scurve_batch_sample(curves, n_jts, t, out, n_threads, chunk_size, jlc_best_isa());
+}
+
+
+void scurve_batch_sample(const CompiledScurve *curves, int n_jts, const double *t, const scurve_samples &out,
+                         int n_threads, size_t chunk_size, jlc_isa isa){
+    const size_t n = out.n_samples;
+    if (n_jts <= 0 || n == 0)
+        return;
+    if (isa > jlc_best_isa())
+        isa = jlc_best_isa();
+    if (chunk_size == 0)
+        chunk_size = n;
+
+    // chunks of a joint and chunk_size times, joint after joint
+    std::vector<batch_chunk> chunks;
+    const size_t n_per_jt = (n + chunk_size - 1) / chunk_size;
+    chunks.reserve(n_jts*n_per_jt);
+    for (int jt=0; jt<n_jts; jt++)
+        for (size_t begin=0; begin<n; begin+=chunk_size) {
+            const size_t off = (size_t)jt*n;
+            batch_chunk c = {&curves[jt], t, begin, std::min(n, begin + chunk_size),
+                             out.p ? out.p + off : NULL, out.v ? out.v + off : NULL,
+                             out.a ? out.a + off : NULL, out.j ? out.j + off : NULL};
+            chunks.push_back(c);
+        }
+
+    if (n_threads <= 0)
+        n_threads = std::max(1u, std::thread::hardware_concurrency());
+    n_threads = std::min<size_t>(n_threads, chunks.size());
+
+    struct worker {
+        static void run(const batch_chunk *c, size_t n_chunks, jlc_isa isa){
+            for (size_t i=0; i<n_chunks; i++)
+                sample_chunk(c[i], isa);
+        }
+    };
+    if (n_threads == 1) {
+        worker::run(chunks.data(), chunks.size(), isa);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(n_threads - 1);
+    size_t begin = 0;
+    for (int th=0; th<n_threads; th++) {
+        const size_t count = chunks.size() / n_threads + (th < (int)(chunks.size() % n_threads) ? 1 : 0);
+        if (th == n_threads - 1)
+            worker::run(chunks.data() + begin, count, isa);   // the calling thread takes the last chunks
+        else
+            workers.push_back(std::thread(&worker::run, chunks.data() + begin, count, isa));
+        begin += count;
+    }
+    for (size_t th=0; th<workers.size(); th++)
+        workers[th].join();
+}
@@ -0,0 +1,43 @@
+/**
+\file   scurve_batch.h
+\brief  dense sampling of the compiled s_curves of all the joints at once, for previews, collision checks and
+        the export of whole programs to the drives.
+ *
+ *  the n_samples times t[] are sampled for the n_jts curves (CompiledScurve, one per joint) into
+ *  structure-of-arrays buffers: value of joint jt at sample k in p[jt*n_samples + k] (same for v, a, j).
+ *  per joint the phase of every sample is found with a cursor (O(1) per sample for increasing times, a binary
+ *  search otherwise), the cubics of 4 (AVX2) or 8 (AVX-512) samples are gathered and evaluated together, the
+ *  instruction set is chosen at run time like jlc_simd_kernel. the results are the same numbers as
+ *  CompiledScurve::sample (no FMA, same evaluation order). the times outside [0, duration] of a curve are
+ *  clamped: the joint holds its start before 0 and its last position after the end.
+ *  the work is cut in chunks of a joint and chunk_size times, spread over n_threads threads (0: one per core).
+ *
+ *  usage:
+ *      std::vector<CompiledScurve> curves(n_jts);  ...compile...
+ *      scurve_samples out = {n_samples, p, v, a, j};     // any buffer may be NULL
+ *      scurve_batch_sample(curves.data(), n_jts, t, out, 0);
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef SCURVE_BATCH_H
+#define SCURVE_BATCH_H
+
+#include <stddef.h>
+#include "compiled_scurve.h"
+#include "jlc_simd_kernel.h"
+
+
+// output buffers of a batch, n_jts*n_samples values each, NULL: not computed
+struct scurve_samples {
+    size_t n_samples;
+    double *p, *v, *a, *j;
+};
+
+// samples the n_jts curves at the times t[0..out.n_samples-1] into out
+void scurve_batch_sample(const CompiledScurve *curves, int n_jts, const double *t, const scurve_samples &out,
+                         int n_threads = 1, size_t chunk_size = 4096);
+void scurve_batch_sample(const CompiledScurve *curves, int n_jts, const double *t, const scurve_samples &out,
+                         int n_threads, size_t chunk_size, jlc_isa isa);
+
+#endif // SCURVE_BATCH_H
@@ -0,0 +1,70 @@
+/**
+\file   velocity_jogging_controller.cpp
+\brief  velocity jogging controller, see velocity_jogging_controller.h
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#include "velocity_jogging_controller.h"
+
+static const double sm=180,  vm=130,  am=250, jm=1000, default_frq=125;
+
+
+VelocityJoggingController::VelocityJoggingController(const ros::NodeHandle &nh, const ros::NodeHandle &pnh):
+    ControllerNode<N_JOINTS>(nh, pnh, "/out_state", default_frq),
+    last_cmd_version_(0), limits_(sm)
+{
+    // velocity controller: position gain is zero, so only vel and acc are tracked
+    controller_.set_limits(sm, vm, am, jm);
+    controller_.set_gains(0, 20, 8);
+    step_trace_ = trace_.add_event("STEP:", {"in_vel=", "out_pos=", "out_vel=", "out_acc="});
+    stop_dist_trace_ = trace_.add_event("STEP: stop_dist=");
+    sub_cmd_vel_ = nh_.subscribe("/cmd_vel", 100, &VelocityJoggingController::cmd_call_back, this);
+}
+
+
+VelocityJoggingController::~VelocityJoggingController(){
+    stop();
+}
+
+
+// command velocities call_back
+void VelocityJoggingController::cmd_call_back(const std_msgs::Float64MultiArray::ConstPtr &msg){
+    if((int)msg->data.size() < n_joints){
+        ROS_WARN_STREAM("cmd_vel has " << msg->data.size() << " values, expected " << n_joints << " joints");
+        return;
+    }
+    joint_velocities cmd_vel;
+    for(int jt=0; jt<n_joints; jt++){
+        cmd_vel.vel[jt] = msg->data[jt];
+        if(cmd_vel.vel[jt] > sm)
+            cmd_vel.vel[jt] = sm;
+        if(cmd_vel.vel[jt] < -sm)
+            cmd_vel.vel[jt] = -sm;
+    }
+    last_cmd_vel_block_.write(cmd_vel);
+}
+
+
+// one loop: cmd_vel (or zero near the limits), substeps of the controller, publish
+void VelocityJoggingController::cycle(){
+    last_cmd_vel_block_.read_newer(last_cmd_, last_cmd_version_);
+    if(last_cmd_version_ == 0) // no cmd_vel has been recevied
+        return;
+
+    // setting right velocity (cmd_vel or zero if near to the limit)
+    controller_type::inputs &ctrl_U = controller_.input();
+    limits_.apply(last_cmd_.vel, ctrl_U.vel);
+
+    // run the model STEP fumction, substeps times with the same cmd_vel, publish the state with cmd_vel
+    step_and_publish(ctrl_U.vel);
+
+    //check pos_limits
+    const controller_type::outputs &ctrl_Y = controller_.output();
+    limits_.update(ctrl_Y.POS, ctrl_Y.VEL);
+
+    // logged by the trace thread
+    const double step_values[4] = {ctrl_U.vel[0], ctrl_Y.POS[0], ctrl_Y.VEL[0], ctrl_Y.ACC[0]};
+    trace_.record(step_trace_, step_values, 4);
+    trace_.record(stop_dist_trace_, limits_.stop_dist(), n_joints);
+}
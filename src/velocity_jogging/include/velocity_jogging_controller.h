@@ -0,0 +1,49 @@
+/**
+\file   velocity_jogging_controller.h
+\brief  velocity jogging controller, used by velocity_jogging_node and its nodelet.
+ *
+ *  subscribes to "/cmd_vel" (velocity of each joint, clamped to +-sm), the controller is JerkLimitedController
+ *  with kp=0 so only vel and acc are tracked. when the stop distance of a joint reaches its position limit the
+ *  velocity of that joint is set to zero, unless the command moves it back from the limit (jogging_limits.h).
+ *  the state is published on "/out_state" (controller_node.h in trajectory_controller).
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#ifndef VELOCITY_JOGGING_CONTROLLER_H
+#define VELOCITY_JOGGING_CONTROLLER_H
+
+#include "controller_node.h"
+#include "seqlock_block.h"
+#include "jogging_limits.h"
+
+#ifndef N_JOINTS
+#define N_JOINTS 6
+#endif
+
+
+class VelocityJoggingController: public ControllerNode<N_JOINTS>
+{
+public:
+    VelocityJoggingController(const ros::NodeHandle &nh, const ros::NodeHandle &pnh);
+    ~VelocityJoggingController();
+
+private:
+    struct joint_velocities {
+        double vel[N_JOINTS];
+    };
+
+    void cmd_call_back(const std_msgs::Float64MultiArray::ConstPtr &msg);
+    void cycle();
+
+    // last cmd_vel received, read by the control loop without locks
+    SeqlockBlock<joint_velocities> last_cmd_vel_block_;
+    ros::Subscriber sub_cmd_vel_;
+    joint_velocities last_cmd_;
+    uint64_t last_cmd_version_;   // 0: no cmd_vel has been recevied
+    JoggingLimits<N_JOINTS> limits_;
+    int step_trace_;              // trace events of every loop: cmd_vel and state of joint 0, stop distances
+    int stop_dist_trace_;
+};
+
+#endif // VELOCITY_JOGGING_CONTROLLER_H
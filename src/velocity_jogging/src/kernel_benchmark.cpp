@@ -0,0 +1,757 @@
+/**
+\file   kernel_benchmark.cpp
+\brief  cost of the controller kernels and of the S-curve math, the baseline to hold the optimizations against.
+ *
+ *  usage: kernel_benchmark [n_reps=7]
+ *  a few checks of the S-curve functions run first (cases they got wrong), the exit code is 1 if one fails.
+ *  every function is timed over a few thousand inputs drawn (fixed seed) from the distributions it sees in
+ *  the nodes, each measurement is repeated n_reps times and printed as median and min ns per call:
+ *      controllers  six_dof_pos_controller step and derivatives (waypoints in [-90, 90] deg held for 1-3 s),
+ *                   six_dof_vel_controller step (cmd_vel in [-35, 35] deg/s held for 1.35-5 s, like
+ *                   cmd_vel_publisher), JerkLimitedController<6> ode3 step with each instruction set
+ *                   (the full ode3 update of the nodes, the generated step includes its own)
+ *      S-curve      distances uniform in (0, 180] deg (the three cases of the limits below), paths of 2 to 6
+ *                   waypoints in [-90, 90] deg sampled at 125 Hz, states (p, v >= 0, a) within the limits,
+ *                   cubics of the jerk time (2 jm t^3 = Ds) and with random coefficients, paths of 2 to 6
+ *                   waypoints of the 6 joints planned synchronized (n_dof_scurve_coef) and sampled at 125 Hz,
+ *                   the one joint paths compiled (CompiledScurve) and sampled in random order or streamed,
+ *                   64 of the 6 joint paths as one program exported at 4 kHz (p, v, a, j of every joint)
+ *  the kernels of scurve_planning.h are timed on the same inputs as the functions they replace, and the
+ *  functions that became their wrappers also in their original form (legacy_*, the baseline).
+ *  the output of the functions is sent to /dev/null while timing (the model logging of the controllers).
+ *  no ros needed.
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "six_dof_pos_controller.h"
+#include "six_dof_vel_controller.h"
+#include "jerk_limited_controller.h"
+#include "compiled_scurve.h"
+#include "scurve_batch.h"
+
+#include "scurve_planning.h"
+#include "dyn_limiter_funcs.h"
+#include "s_curve_functions.cpp"   // not in any library
+
+const double sm=180,  vm=130,  am=250;
+const double pos_jm=985, pos_kp=1200, pos_kv=400, pos_ka=20;   // controller_approaching_each_waypoint
+const double vel_jm=1000, vel_kv=20, vel_ka=8;                  // velocity_jogging_node
+const int n_jts = 6;
+const int n_steps = 20000;   // controller steps per measurement (160 s at 125 Hz)
+const int n_inputs = 4096;   // inputs per measurement of the S-curve functions
+
+int n_reps = 7;
+volatile double sink;        // results are added here so the calls are not optimized out
+std::mt19937 rng(12345);
+
+
+double now_sec(){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double uniform(double lo, double hi){
+    return std::uniform_real_distribution<double>(lo, hi)(rng);
+}
+
+// sends stdout to /dev/null during its scope
+class QuietStdout
+{
+public:
+    QuietStdout(){
+        std::cout.flush();
+        fflush(stdout);
+        saved_ = dup(STDOUT_FILENO);
+        const int null_fd = open("/dev/null", O_WRONLY);
+        dup2(null_fd, STDOUT_FILENO);
+        close(null_fd);
+    }
+    ~QuietStdout(){
+        std::cout.flush();
+        fflush(stdout);
+        dup2(saved_, STDOUT_FILENO);
+        close(saved_);
+    }
+private:
+    int saved_;
+};
+
+// runs fn (n_ops calls, returns its time) n_reps times, prints the median and min per call
+template<class Fn>
+void bench(const char *name, int n_ops, Fn fn){
+    std::vector<double> t(n_reps);
+    {
+        QuietStdout quiet;   // the prints of the functions and of the model logging
+        fn();                // warm up the caches and the branch predictors
+        for (int r=0; r<n_reps; r++)
+            t[r] = fn();
+    }
+    std::sort(t.begin(), t.end());
+    printf("%-44s %9.1f ns/call   (min %9.1f)\n", name, 1e9*t[n_reps/2]/n_ops, 1e9*t[0]/n_ops);
+}
+
+// joint values held for a random number of steps in [min_hold, max_hold]
+std::vector<double> held_inputs(double lo, double hi, int min_hold, int max_hold){
+    std::vector<double> u((size_t)n_steps*n_jts);
+    for (int jt=0; jt<n_jts; jt++) {
+        int k = 0;
+        while (k < n_steps) {
+            const double value = uniform(lo, hi);
+            const int hold = std::uniform_int_distribution<int>(min_hold, max_hold)(rng);
+            for (int i=0; i<hold && k<n_steps; i++, k++)
+                u[(size_t)k*n_jts + jt] = value;
+        }
+    }
+    return u;
+}
+
+
+// ============================== controllers ==============================
+void bench_pos_controller(const std::vector<double> &setpoints){
+    six_dof_pos_controllerModelClass model;
+    P_six_dof_pos_controller_T prm = model.getBlockParameters();
+    ExtU_six_dof_pos_controller_T u;
+    for (int jt=0; jt<n_jts; jt++) {
+        prm.sm[jt] = sm;  prm.vm[jt] = vm;  prm.am[jt] = am;  prm.jm[jt] = pos_jm;
+        prm.kp[jt] = pos_kp;  prm.kv[jt] = pos_kv;  prm.ka[jt] = pos_ka;
+        u.pos[jt] = 0;  u.vel[jt] = 0;  u.acc[jt] = 0;
+    }
+    model.setBlockParameters(&prm);
+
+    bench("six_dof_pos_controller step", n_steps, [&](){
+        model.initialize();
+        const double t0 = now_sec();
+        for (int k=0; k<n_steps; k++) {
+            for (int jt=0; jt<n_jts; jt++)
+                u.pos[jt] = setpoints[(size_t)k*n_jts + jt];
+            model.setExternalInputs(&u);
+            model.step();
+        }
+        const double t = now_sec() - t0;
+        sink = sink + model.getExternalOutputs().POS[0];
+        return t;
+    });
+
+    // at the state reached by the moves above, the derivatives only read the block signals
+    bench("six_dof_pos_controller derivatives", n_steps, [&](){
+        const double t0 = now_sec();
+        for (int k=0; k<n_steps; k++)
+            model.derivatives();
+        return now_sec() - t0;
+    });
+    model.terminate();
+}
+
+void bench_vel_controller(const std::vector<double> &cmd_vel){
+    for (int jt=0; jt<n_jts; jt++) {
+        six_dof_vel_controller_P.sm[jt] = sm;
+        six_dof_vel_controller_P.vm[jt] = vm;
+        six_dof_vel_controller_P.am[jt] = am;
+        six_dof_vel_controller_P.jm[jt] = vel_jm;
+        six_dof_vel_controller_P.kv[jt] = vel_kv;
+        six_dof_vel_controller_P.ka[jt] = vel_ka;
+    }
+    bench("six_dof_vel_controller step", n_steps, [&](){
+        six_dof_vel_controller_initialize();
+        const double t0 = now_sec();
+        for (int k=0; k<n_steps; k++) {
+            for (int jt=0; jt<n_jts; jt++) {
+                six_dof_vel_controller_U.vel[jt] = cmd_vel[(size_t)k*n_jts + jt];
+                six_dof_vel_controller_U.acc[jt] = 0;
+            }
+            six_dof_vel_controller_step();
+        }
+        const double t = now_sec() - t0;
+        sink = sink + six_dof_vel_controller_Y.POS[0];
+        return t;
+    });
+    six_dof_vel_controller_terminate();
+}
+
+void bench_ode3(const std::vector<double> &setpoints){
+    for (int isa=JLC_ISA_SCALAR; isa<=jlc_best_isa(); isa++) {
+        JerkLimitedController<n_jts> ctrl;
+        ctrl.set_limits(sm, vm, am, pos_jm);
+        ctrl.set_gains(pos_kp, pos_kv, pos_ka);
+        ctrl.set_solver(JLC_SOLVER_ODE3);
+        ctrl.set_isa((jlc_isa)isa);
+        char name[64];
+        snprintf(name, sizeof(name), "JerkLimitedController<6> ode3 step %s", jlc_isa_name((jlc_isa)isa));
+        bench(name, n_steps, [&](){
+            ctrl.initialize();
+            const double t0 = now_sec();
+            for (int k=0; k<n_steps; k++) {
+                for (int jt=0; jt<n_jts; jt++)
+                    ctrl.input().pos[jt] = setpoints[(size_t)k*n_jts + jt];
+                ctrl.step();
+            }
+            const double t = now_sec() - t0;
+            sink = sink + ctrl.output().POS[0];
+            return t;
+        });
+    }
+}
+
+
+// ============================== S-curve ==============================
+// the S-curve math as it was before scurve_planning.h, kept here as the baseline of the kernels that replaced
+// it (the wrappers of the same names in s_curve_functions.cpp and dyn_limiter_funcs.h), prints included
+
+int legacy_cubic_eq_real_root(double a, double b, double c, double d, std::vector<double> &roots){
+    if (a == 0.000)
+        throw(std::invalid_argument("The coefficient of the cube of x is 0. Please use the utility for a SECOND degree quadratic. No further action taken."));
+    if (d == 0.000)
+        return 0;
+    b /= a;
+    c /= a;
+    d /= a;
+    double disc, q, r, dum1, s, t, term1, r13;
+    q = (3.0*c - (b*b))/9.0;
+    r = -(27.0*d) + b*(9.0*c - 2.0*(b*b));
+    r /= 54.0;
+    disc = q*q*q + r*r;
+    term1 = (b/3.0);
+    if (disc > 1e-10) { // one root real, two are complex
+        s = r + sqrt(disc);
+        s = ((s < 0) ? -pow(-s, (1.0/3.0)) : pow(s, (1.0/3.0)));
+        t = r - sqrt(disc);
+        t = ((t < 0) ? -pow(-t, (1.0/3.0)) : pow(t, (1.0/3.0)));
+        roots[0] = -term1 + s + t;
+        roots[1] = -100.0;
+        roots[2] = -100.0;
+        return 1;
+    }
+    if (disc>=0.000 && disc< 1e-10){ // all roots real, at least two are equal
+        r13 = ((r < 0) ? -pow(-r,(1.0/3.0)) : pow(r,(1.0/3.0)));
+        roots[0] = -term1 + 2.0*r13;
+        roots[1] = -(r13 + term1);
+        roots[2] = -(r13 + term1);
+        return 2;
+    }
+    // all roots real and unequal (q < 0)
+    q = -q;
+    dum1 = q*q*q;
+    dum1 = acos(r/sqrt(dum1));
+    r13 = 2.0*sqrt(q);
+    roots[0] = -term1 + r13*cos(dum1/3.0);
+    roots[1] = -term1 + r13*cos((dum1 + 2.0*M_PI)/3.0);
+    roots[2] = -term1 + r13*cos((dum1 + 4.0*M_PI)/3.0);
+    return 3;
+}
+
+double legacy_compute_time_for_jrk(const double Ds, double &Tj, double &Ta, double &Tv, const double sm, const double vm, const double am, const double jm){
+    double Dthr1 = (am*vm)/jm + (vm*vm)/am ;
+    double Dthr2 = 2*pow(am,3)/pow(jm,2);
+    double Tjm= am/jm;
+    double Tam= (vm/am) - (am/jm);
+    if (Ds>= Dthr1){
+        Tj= Tjm;
+        Ta= Tam;
+        Tv= (Ds-Dthr1)/vm;
+    }
+    else if(Ds>=Dthr2){
+        Tj= Tjm;
+        Tv= 0;
+        double jr = jm;
+        double Ta1 = -(3*pow(Tj,2)*jr - sqrt(Tj*jr*(jr*pow(Tj,3) + 2*jr*pow(Tj,2)*Tv + jr*Tj*pow(Tv,2) + 4*Ds)) + Tj*Tv*jr)/(2*Tj*jr);
+        double Ta2 = -(3*pow(Tj,2)*jr + sqrt(Tj*jr*(jr*pow(Tj,3) + 2*jr*pow(Tj,2)*Tv + jr*Tj*pow(Tv,2) + 4*Ds)) + Tj*Tv*jr)/(2*Tj*jr);
+        std::cout<<" Ta1: "<< Ta1 <<"   Ta2: "<< Ta2 <<std::endl;
+        Ta = min_root(Ta1, Ta2);
+    }else {
+        Tv=0;
+        Ta=0;
+        std::vector<double> rts;
+        rts.resize(3);
+        int sgn = (Ds>0)? 1:-1;
+        legacy_cubic_eq_real_root(2*sgn*jm, 0.0, 0.0, -Ds, rts);
+        Tj= rts[0];
+    }
+    return 4*Tj+2*Ta+Tv;
+}
+
+double legacy_compute_init_time(const double Ds, double &Tj, double &Ta, double &Tv, const double sm, const double vm, const double am, const double jm){
+    double Dthr1 = (am*vm)/jm + (vm*vm)/am ;
+    double Dthr2 = 2*pow(am,3)/pow(jm,2);
+    double Tjm= am/jm, Tam= vm/am - am/jm;
+    if (Ds>= Dthr1){
+        std::cout<<" init case 1 ... "<<std::endl;
+        Tj= Tjm;
+        Ta= Tam;
+        Tv= (Ds-Dthr1)/vm;
+    }
+    else if(Ds>=Dthr2){
+        std::cout<<" init case 3 ... "<<std::endl;
+        Tj= Tjm;
+        Ta= sqrt( (am*am/(4*jm)) + (Ds/am) ) - (3*am)/(2*jm);
+        Tv= 0;
+    }else {
+        std::cout<<" init case 3 ... "<<std::endl;
+        Tv=0;
+        Ta=0;
+        std::vector<double> rts;
+        rts.resize(3);
+        int sgn = (Ds>0)? 1:-1;
+        legacy_cubic_eq_real_root(2*sgn*jm, 0.0, 0.0, -Ds, rts);
+        Tj= rts[0];
+    }
+    return 4*Tj+2*Ta+Tv;
+}
+
+double legacy_compute_stop_distance(double a0, double v0, double p0, double am, double vm, double jm){
+    double t1=0, t2=0, a1=0, p1=0, p2=0;
+    double v1=0;
+    if( fabs(v0) <= 0.001 && fabs(a0) <=0.001){
+        p2=0;
+        return p2;
+    }
+    t2 = sqrt( pow(a0,2)/(2*pow(jm,2)) + (v0/jm));
+    t1 = t2 +(a0/jm);
+    a1= -jm*t1 +a0;
+    v1 = -jm*pow(t1,2)/2 +a0*t1+v0;
+    p1 = -jm*pow(t1,3)/6 + a0*pow(t1,2)/2 + v0*t1 +p0;
+    p2 =  jm*pow(t2,3)/6 + a1*pow(t2,2)/2 + v1*t2 +p1;
+    return p2;
+}
+
+
+// coefficients of a path computed by one_dof_scurve_coef
+struct scurve_path {
+    std::vector<double> wpts;
+    double T_opt;
+    std::vector< std::vector<double> > traj_T;
+    std::vector<double> jrk;
+    std::vector<double> seg_idx;
+};
+
+void bench_scurve(){
+    std::vector<double> Ds(n_inputs);
+    for (int i=0; i<n_inputs; i++)
+        Ds[i] = uniform(1e-3, sm);
+
+    // before and after scurve_planning.h
+    typedef double (*time_fn)(double, double&, double&, double&, double, double, double, double);
+    const struct { const char *name; time_fn fn; } time_fns[] = {
+        {"legacy compute_time_for_jrk", &legacy_compute_time_for_jrk},
+        {"compute_time_for_jrk", &compute_time_for_jrk},
+        {"legacy compute_init_time", &legacy_compute_init_time},
+        {"compute_init_time", &compute_init_time}};
+    for (size_t f=0; f<sizeof(time_fns)/sizeof(time_fns[0]); f++) {
+        const time_fn fn = time_fns[f].fn;
+        bench(time_fns[f].name, n_inputs, [&](){
+            const double t0 = now_sec();
+            double Tj, Ta, Tv, T = 0;
+            for (int i=0; i<n_inputs; i++)
+                T += fn(Ds[i], Tj, Ta, Tv, sm, vm, am, vel_jm);
+            const double t = now_sec() - t0;
+            sink = sink + T;
+            return t;
+        });
+    }
+
+    // the optimal times of the distances stretched by up to 50 %
+    struct stretch { double T, DT, Ds, Tj, Ta, Tv; };
+    std::vector<stretch> stretches(n_inputs);
+    {
+        QuietStdout quiet;
+        for (int i=0; i<n_inputs; i++) {
+            stretch &s = stretches[i];
+            s.Ds = Ds[i];
+            s.T = compute_time_for_jrk(s.Ds, s.Tj, s.Ta, s.Tv, sm, vm, am, vel_jm);
+            s.DT = uniform(0, 0.5)*s.T;
+        }
+    }
+    bench("compute_jerk_for_time", n_inputs, [&](){
+        const double t0 = now_sec();
+        double jrk = 0;
+        for (int i=0; i<n_inputs; i++) {
+            stretch s = stretches[i];   // its times are updated
+            jrk += compute_jerk_for_time(s.T, s.DT, s.Ds, s.Tj, s.Ta, s.Tv, sm, vm, am, vel_jm);
+        }
+        const double t = now_sec() - t0;
+        sink = sink + jrk;
+        return t;
+    });
+
+    std::vector<double> a0(n_inputs), v0(n_inputs), p0(n_inputs);
+    for (int i=0; i<n_inputs; i++) {
+        a0[i] = uniform(-am, am);
+        v0[i] = uniform(0, vm);
+        p0[i] = uniform(-sm, sm);
+    }
+    typedef double (*stop_fn)(double, double, double, double, double, double);
+    const struct { const char *name; stop_fn fn; } stop_fns[] = {
+        {"legacy compute_stop_distance", &legacy_compute_stop_distance},
+        {"compute_stop_distance", &compute_stop_distance}};
+    for (size_t f=0; f<sizeof(stop_fns)/sizeof(stop_fns[0]); f++) {
+        const stop_fn fn = stop_fns[f].fn;
+        bench(stop_fns[f].name, n_inputs, [&](){
+            const double t0 = now_sec();
+            double d = 0;
+            for (int i=0; i<n_inputs; i++)
+                d += fn(a0[i], v0[i], p0[i], am, vm, vel_jm);
+            const double t = now_sec() - t0;
+            sink = sink + d;
+            return t;
+        });
+    }
+
+    // cubics: the jerk time of the short moves, and random coefficients (one to three real roots)
+    std::vector<double> cb(4*n_inputs);
+    for (int i=0; i<n_inputs; i++) {
+        cb[4*i]   = uniform(0.5, 2)*(i & 1 ? 1 : -1);
+        cb[4*i+1] = uniform(-10, 10);
+        cb[4*i+2] = uniform(-10, 10);
+        cb[4*i+3] = uniform(-10, 10);
+    }
+    typedef int (*cubic_fn)(double, double, double, double, std::vector<double>&);
+    const struct { const char *name; cubic_fn fn; } cubic_fns[] = {
+        {"legacy cubic_eq_real_root", &legacy_cubic_eq_real_root},
+        {"cubic_eq_real_root", &cubic_eq_real_root}};
+    std::vector<double> roots(3);
+    for (size_t f=0; f<sizeof(cubic_fns)/sizeof(cubic_fns[0]); f++) {
+        const cubic_fn fn = cubic_fns[f].fn;
+        bench((std::string(cubic_fns[f].name) + " jerk").c_str(), n_inputs, [&](){
+            const double t0 = now_sec();
+            int n = 0;
+            for (int i=0; i<n_inputs; i++)
+                n += fn(2*vel_jm, 0, 0, -Ds[i], roots);
+            const double t = now_sec() - t0;
+            sink = sink + n + roots[0];
+            return t;
+        });
+        bench((std::string(cubic_fns[f].name) + " random").c_str(), n_inputs, [&](){
+            const double t0 = now_sec();
+            int n = 0;
+            for (int i=0; i<n_inputs; i++)
+                n += fn(cb[4*i], cb[4*i+1], cb[4*i+2], cb[4*i+3], roots);
+            const double t = now_sec() - t0;
+            sink = sink + n + roots[0];
+            return t;
+        });
+    }
+    bench("scurve_cubic_real_roots random", n_inputs, [&](){
+        double rts[3];
+        const double t0 = now_sec();
+        int n = 0, n_rts;
+        for (int i=0; i<n_inputs; i++) {
+            scurve_cubic_real_roots(cb[4*i], cb[4*i+1], cb[4*i+2], cb[4*i+3], rts, n_rts);
+            n += n_rts;
+        }
+        const double t = now_sec() - t0;
+        sink = sink + n + rts[0];
+        return t;
+    });
+
+    // paths of 2 to 6 waypoints, their optimal time and a reference time 20 % longer
+    const int n_paths = 512;
+    std::vector<scurve_path> paths(n_paths);
+    {
+        QuietStdout quiet;
+        for (int i=0; i<n_paths; i++) {
+            scurve_path &p = paths[i];
+            const int n_wpts = std::uniform_int_distribution<int>(2, 6)(rng);
+            for (int w=0; w<n_wpts; w++)
+                p.wpts.push_back(uniform(-90, 90));
+            p.traj_T.resize(4);
+            one_dof_scurve_coef(p.wpts, 0, p.traj_T, p.jrk, p.seg_idx, sm, vm, am, vel_jm);
+            p.T_opt = 0;
+            for (size_t s=0; s<p.traj_T[3].size(); s++)
+                p.T_opt += p.traj_T[3][s];
+        }
+    }
+    for (int stretched=0; stretched<2; stretched++) {
+        bench(stretched ? "one_dof_scurve_coef ref_T = 1.2 T_opt" : "one_dof_scurve_coef ref_T = 0", n_paths, [&](){
+            std::vector< std::vector<double> > traj_T(4);
+            std::vector<double> jrk, seg_idx;
+            const double t0 = now_sec();
+            for (int i=0; i<n_paths; i++) {
+                seg_idx.clear();
+                one_dof_scurve_coef(paths[i].wpts, stretched ? 1.2*paths[i].T_opt : 0, traj_T, jrk, seg_idx,
+                                    sm, vm, am, vel_jm);
+            }
+            const double t = now_sec() - t0;
+            sink = sink + jrk[0];
+            return t;
+        });
+    }
+    // the same plans into a buffer: one_dof_scurve_coef is the wrapper of scurve_plan_1dof, the difference is
+    // the copy into its vectors (its original form cut where the sign of the waypoints changed, another plan,
+    // so it is not timed here)
+    const scurve_limits lim = {sm, vm, am, vel_jm};
+    scurve_segment segs[8];
+    size_t n_segs = 0;
+    std::vector<double> plan_T(n_paths, 0);
+    for (int i=0; i<n_paths; i++) {
+        scurve_plan_1dof(scurve_span<const double>(&paths[i].wpts[0], paths[i].wpts.size()), 0, lim,
+                         scurve_span<scurve_segment>(segs, 8), n_segs);
+        for (size_t s=0; s<n_segs; s++)
+            plan_T[i] += segs[s].ph.T;
+    }
+    for (int stretched=0; stretched<2; stretched++) {
+        bench(stretched ? "scurve_plan_1dof ref_T = 1.2 T_opt" : "scurve_plan_1dof ref_T = 0", n_paths, [&](){
+            const double t0 = now_sec();
+            for (int i=0; i<n_paths; i++)
+                scurve_plan_1dof(scurve_span<const double>(&paths[i].wpts[0], paths[i].wpts.size()),
+                                 stretched ? 1.2*plan_T[i] : 0, lim, scurve_span<scurve_segment>(segs, 8), n_segs);
+            const double t = now_sec() - t0;
+            sink = sink + segs[0].ph.jrk;
+            return t;
+        });
+    }
+
+    // the paths sampled at 125 Hz
+    std::vector< std::pair<int, double> > samples;
+    for (int i=0; i<n_paths; i++)
+        for (double tg=0; tg<=paths[i].T_opt; tg+=0.008)
+            samples.push_back(std::make_pair(i, tg));
+    bench("sample_scurve", (int)samples.size(), [&](){
+        std::vector<double> TPVA(4);
+        double p = 0;
+        const double t0 = now_sec();
+        for (size_t i=0; i<samples.size(); i++) {
+            scurve_path &path = paths[samples[i].first];
+            sample_scurve(samples[i].second, path.traj_T, TPVA, path.jrk, path.seg_idx);
+            p += TPVA[1];
+        }
+        const double t = now_sec() - t0;
+        sink = sink + p;
+        return t;
+    });
+
+    // the same samples from the compiled curves, in random order and streamed in order
+    std::vector<CompiledScurve> curves(n_paths);
+    bench("CompiledScurve::compile", n_paths, [&](){
+        const double t0 = now_sec();
+        for (int i=0; i<n_paths; i++)
+            curves[i].compile(paths[i].traj_T, paths[i].jrk, paths[i].seg_idx);
+        const double t = now_sec() - t0;
+        sink = sink + curves[0].duration();
+        return t;
+    });
+    std::vector< std::pair<int, double> > shuffled = samples;
+    std::shuffle(shuffled.begin(), shuffled.end(), rng);
+    bench("CompiledScurve::sample random order", (int)shuffled.size(), [&](){
+        double p = 0, v, a, j, sp = 0;
+        const double t0 = now_sec();
+        for (size_t i=0; i<shuffled.size(); i++) {
+            curves[shuffled[i].first].sample(shuffled[i].second, sp, v, a, j);
+            p += sp;
+        }
+        const double t = now_sec() - t0;
+        sink = sink + p;
+        return t;
+    });
+    bench("CompiledScurve::sample cursor", (int)samples.size(), [&](){
+        CompiledScurve::cursor cur;
+        int path = -1;
+        double p = 0, v, a, j, sp = 0;
+        const double t0 = now_sec();
+        for (size_t i=0; i<samples.size(); i++) {
+            if (samples[i].first != path) {
+                path = samples[i].first;
+                cur = CompiledScurve::cursor();
+            }
+            curves[path].sample(samples[i].second, cur, sp, v, a, j);
+            p += sp;
+        }
+        const double t = now_sec() - t0;
+        sink = sink + p;
+        return t;
+    });
+
+    // the same paths for the 6 joints synchronized, and sampled at 125 Hz
+    std::vector< std::vector< std::vector<double> > > n_dof_paths(n_paths);
+    for (int i=0; i<n_paths; i++) {
+        const int n_wpts = std::uniform_int_distribution<int>(2, 6)(rng);
+        n_dof_paths[i].resize(n_wpts, std::vector<double>(n_jts));
+        for (int w=0; w<n_wpts; w++)
+            for (int jt=0; jt<n_jts; jt++)
+                n_dof_paths[i][w][jt] = uniform(-90, 90);
+    }
+    const std::vector<double> sm_jt(n_jts, sm), vm_jt(n_jts, vm), am_jt(n_jts, am), jm_jt(n_jts, vel_jm);
+    std::vector<n_dof_scurve> plans(n_paths);
+    bench("n_dof_scurve_coef 6 joints", n_paths, [&](){
+        std::string error;
+        const double t0 = now_sec();
+        for (int i=0; i<n_paths; i++)
+            n_dof_scurve_coef(n_dof_paths[i], 0, plans[i], sm_jt, vm_jt, am_jt, jm_jt, error);
+        const double t = now_sec() - t0;
+        sink = sink + plans[0].duration;
+        return t;
+    });
+    samples.clear();
+    for (int i=0; i<n_paths; i++)
+        for (double tg=0; tg<=plans[i].duration; tg+=0.008)
+            samples.push_back(std::make_pair(i, tg));
+    bench("sample_n_dof_scurve 6 joints", (int)samples.size(), [&](){
+        std::vector<double> P(n_jts), V(n_jts), A(n_jts);
+        double p = 0;
+        const double t0 = now_sec();
+        for (size_t i=0; i<samples.size(); i++) {
+            sample_n_dof_scurve(samples[i].second, plans[samples[i].first], P, V, A);
+            p += P[0];
+        }
+        const double t = now_sec() - t0;
+        sink = sink + p;
+        return t;
+    });
+
+    // dense export: a 6 joint program of the paths one after the other, compiled per joint and sampled at
+    // 4 kHz into p, v, a, j one by one with the cursor and in batch with each instruction set
+    const int n_program = 64;
+    std::vector<CompiledScurve> program(n_jts);
+    for (int jt=0; jt<n_jts; jt++) {
+        for (int i=0; i<n_program; i++) {
+            const n_dof_scurve &plan = plans[i];
+            for (int seg=0; seg<plan.n_segs; seg++)
+                program[jt].add_segment(plan.Tj[seg][jt], plan.Ta[seg][jt], plan.Tv[seg][jt], plan.jrk[seg][jt],
+                                        plan.p0[seg][jt]);
+        }
+    }
+    std::vector<double> grid;
+    for (double tg=0; tg<=program[0].duration(); tg+=0.00025)
+        grid.push_back(tg);
+    const size_t n_grid = grid.size();
+    std::vector<double> out_buf(4*n_jts*n_grid);
+    const scurve_samples out = {n_grid, &out_buf[0], &out_buf[n_jts*n_grid], &out_buf[2*n_jts*n_grid],
+                                &out_buf[3*n_jts*n_grid]};
+    bench("export 4 kHz CompiledScurve::sample cursor", (int)(n_jts*n_grid), [&](){
+        const double t0 = now_sec();
+        for (int jt=0; jt<n_jts; jt++) {
+            CompiledScurve::cursor cur;
+            const size_t off = jt*n_grid;
+            for (size_t k=0; k<n_grid; k++)
+                program[jt].sample(grid[k], cur, out.p[off+k], out.v[off+k], out.a[off+k], out.j[off+k]);
+        }
+        const double t = now_sec() - t0;
+        sink = sink + out.p[n_grid/2];
+        return t;
+    });
+    for (int isa=JLC_ISA_SCALAR; isa<=jlc_best_isa(); isa++) {
+        const std::string name = std::string("export 4 kHz scurve_batch_sample ") + jlc_isa_name((jlc_isa)isa);
+        bench(name.c_str(), (int)(n_jts*n_grid), [&](){
+            const double t0 = now_sec();
+            scurve_batch_sample(program.data(), n_jts, grid.data(), out, 1, 4096, (jlc_isa)isa);
+            const double t = now_sec() - t0;
+            sink = sink + out.p[n_grid/2];
+            return t;
+        });
+    }
+}
+
+
+// ============================== checks ==============================
+// cases the S-curve functions got wrong, run before the timings, returns the number of failed checks
+int check(const char *name, bool ok){
+    printf("check %-62s %s\n", name, ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+int check_scurve(){
+    int failed = 0;
+    // the jerk time of a short move, 2 jm Tj^3 = Ds: one real root (an absolute tolerance on the discriminant
+    // took it for a double root and returned 0.0396)
+    const double Tj_short = cbrt(0.031/2000);
+    double rts[3];
+    int n_rts = 0;
+    scurve_cubic_real_roots(2000, 0, 0, -0.031, rts, n_rts);
+    failed += check("scurve_cubic_real_roots(2000, 0, 0, -0.031) one root cbrt(0.031/2000)",
+                    n_rts == 1 && fabs(rts[0] - Tj_short) < 1e-12);
+    std::vector<double> roots(3);
+    n_rts = cubic_eq_real_root(2000, 0, 0, -0.031, roots);
+    failed += check("cubic_eq_real_root(2000, 0, 0, -0.031) one root cbrt(0.031/2000)",
+                    n_rts == 1 && fabs(roots[0] - Tj_short) < 1e-12);
+    double Tj, Ta, Tv;
+    compute_time_for_jrk(0.031, Tj, Ta, Tv, sm, vm, am, 1000);
+    failed += check("compute_time_for_jrk Ds = 0.031, jm = 1000: Tj = cbrt(0.031/2000)", fabs(Tj - Tj_short) < 1e-12);
+    n_rts = cubic_eq_real_root(1, -6, 11, -6, roots);
+    std::sort(roots.begin(), roots.end());
+    failed += check("cubic_eq_real_root (x-1)(x-2)(x-3): 1, 2, 3", n_rts == 3 && fabs(roots[0] - 1) < 1e-9
+                    && fabs(roots[1] - 2) < 1e-9 && fabs(roots[2] - 3) < 1e-9);
+    n_rts = cubic_eq_real_root(1, -4, 5, -2, roots);
+    failed += check("cubic_eq_real_root (x-1)^2 (x-2): 2, 1", n_rts == 2 && fabs(roots[0] - 2) < 1e-6
+                    && fabs(roots[1] - 1) < 1e-6);
+
+    // limits with am^2/jm > vm: the throwing functions throw (the kernels give SCURVE_BAD_LIMITS and zeros)
+    const double bad_jm = 100;
+    bool thrown = false;
+    try { compute_time_for_jrk(10, Tj, Ta, Tv, sm, vm, am, bad_jm); }
+    catch (const std::invalid_argument &) { thrown = true; }
+    failed += check("compute_time_for_jrk am^2/jm > vm throws", thrown);
+    thrown = false;
+    try { compute_init_time(10, Tj, Ta, Tv, sm, vm, am, bad_jm); }
+    catch (const std::invalid_argument &) { thrown = true; }
+    failed += check("compute_init_time am^2/jm > vm throws", thrown);
+    const double ref_Ts[2] = {0, 5};
+    for (int i=0; i<2; i++) {
+        std::vector<double> wpts = {0, 10, 20};
+        std::vector< std::vector<double> > traj_T(4);
+        std::vector<double> jrk, seg_idx;
+        thrown = false;
+        try { QuietStdout quiet;  one_dof_scurve_coef(wpts, ref_Ts[i], traj_T, jrk, seg_idx, sm, vm, am, bad_jm); }
+        catch (const std::invalid_argument &) { thrown = true; }
+        failed += check(ref_Ts[i] > 0 ? "one_dof_scurve_coef {0, 10, 20} am^2/jm > vm, ref_T = 5 throws"
+                                      : "one_dof_scurve_coef {0, 10, 20} am^2/jm > vm, ref_T = 0 throws", thrown);
+    }
+
+    // the segments end where the direction reverses (they ended where the sign of the waypoints changed, {0, 10, 5}
+    // was one segment from 0 to 5)
+    {
+        std::vector< std::vector<double> > traj_T(4);
+        std::vector<double> jrk, seg_idx;
+        one_dof_scurve_coef({0, 10, 5}, 0, traj_T, jrk, seg_idx, sm, vm, am, vel_jm);
+        failed += check("one_dof_scurve_coef {0, 10, 5}: segments 0 -> 10 -> 5", jrk.size() == 2
+                        && seg_idx.size() == 3 && seg_idx[1] == 10 && seg_idx[2] == 5 && jrk[0] > 0 && jrk[1] < 0);
+    }
+
+    // joints with different limits: the profile of the bottleneck joint exceeded the vm of joint 0, the segment
+    // through the collinear waypoint was planned with other phases per joint and left the line by 8
+    const std::vector< std::vector<double> > line_wpts = {{0, 0}, {20, 10}, {100, 50}};
+    const std::vector<double> vm_2 = {10, 130}, am_2 = {50, 100}, jm_2 = {1000, 100}, sm_2 = {sm, sm};
+    n_dof_scurve plan;
+    std::string error;
+    const bool planned = n_dof_scurve_coef(line_wpts, 0, plan, sm_2, vm_2, am_2, jm_2, error);
+    double off_line = 0, closest = 1e9, over_limits = 0;
+    std::vector<double> P(2), V(2), A(2);
+    for (int i=0; planned && i<=20000; i++) {
+        sample_n_dof_scurve(plan.duration*i/20000, plan, P, V, A);
+        off_line = std::max(off_line, fabs(P[0]*50 - P[1]*100)/sqrt(50.0*50 + 100*100));
+        closest = std::min(closest, hypot(P[0] - 20, P[1] - 10));
+        for (int jt=0; jt<2; jt++)
+            over_limits = std::max(over_limits, std::max(fabs(V[jt])/vm_2[jt], fabs(A[jt])/am_2[jt]) - 1);
+    }
+    failed += check("n_dof_scurve_coef {0,0}, {20,10}, {100,50} other limits: on the line", planned
+                    && off_line < 1e-9 && closest < 1e-2 && over_limits < 1e-9);
+    return failed;
+}
+
+
+int main(int argc, char **argv)
+{
+    n_reps = argc > 1 ? std::max(1, atoi(argv[1])) : 7;
+    const int failed = check_scurve();
+    printf("\nrepetitions: %d, best kernel: %s\n\n", n_reps, jlc_isa_name(jlc_best_isa()));
+
+    const std::vector<double> setpoints = held_inputs(-90, 90, 125, 375);
+    const std::vector<double> cmd_vel = held_inputs(-35, 35, 169, 625);
+    bench_pos_controller(setpoints);
+    bench_vel_controller(cmd_vel);
+    bench_ode3(setpoints);
+    printf("\n");
+    bench_scurve();
+    if (failed)
+        printf("\n%d checks FAILED\n", failed);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,25 @@
+/**
+\file   velocity_jogging_nodelets.cpp
+\brief  nodelets of the velocity jogging controller and of the velocity publisher (nodelet_plugins.xml).
+ *
+ *  velocity_jogging/VelocityJoggingNodelet:  velocity_jogging_node
+ *  velocity_jogging/CmdVelPublisherNodelet:  cmd_vel_publisher
+ *  same topics and private parameters as the executables, e.g. launch/jogging_pipeline.launch
+\author  Mahmoud Ali
+\date    17/10/2026
+*/
+
+#include "pluginlib/class_list_macros.h"
+#include "pipeline_nodelet.h"
+#include "velocity_jogging_controller.h"
+#include "cmd_vel_publisher.h"
+
+
+namespace velocity_jogging
+{
+typedef PipelineNodelet<VelocityJoggingController> VelocityJoggingNodelet;
+typedef PipelineNodelet<CmdVelPublisher> CmdVelPublisherNodelet;
+}
+
+PLUGINLIB_EXPORT_CLASS(velocity_jogging::VelocityJoggingNodelet, nodelet::Nodelet)
+PLUGINLIB_EXPORT_CLASS(velocity_jogging::CmdVelPublisherNodelet, nodelet::Nodelet)